@@ -18,6 +18,9 @@
 
 #include <tet_api.h>
 #include <media/recorder.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #define MY_ASSERT( fun , test , msg ) \
 {\
@@ -70,6 +73,53 @@ static void utc_media_recorder_set_filename_p(void);
 static void utc_media_recorder_set_filename_n(void);
 static void utc_media_recorder_set_video_encoder_p(void);
 static void utc_media_recorder_set_video_encoder_n(void);
+static void utc_media_recorder_attr_commit_p(void);
+static void utc_media_recorder_attr_commit_n(void);
+static void utc_media_recorder_attr_rollback_p(void);
+static void utc_media_recorder_attr_rollback_n(void);
+static void utc_media_recorder_apply_profile_p(void);
+static void utc_media_recorder_apply_profile_n(void);
+static void utc_media_recorder_profile_deserialize_p(void);
+static void utc_media_recorder_profile_deserialize_n(void);
+static void utc_media_recorder_import_config_p(void);
+static void utc_media_recorder_import_config_n(void);
+static void utc_media_recorder_get_supported_audio_encoders_p(void);
+static void utc_media_recorder_get_supported_audio_encoders_n(void);
+static void utc_media_recorder_is_audio_encoder_compatible_p(void);
+static void utc_media_recorder_is_audio_encoder_compatible_n(void);
+static void utc_media_recorder_pool_acquire_p(void);
+static void utc_media_recorder_pool_acquire_n(void);
+static void utc_media_recorder_prepare_async_p(void);
+static void utc_media_recorder_prepare_async_n(void);
+static void utc_media_recorder_commit_async_p(void);
+static void utc_media_recorder_commit_async_n(void);
+static void utc_media_recorder_split_p(void);
+static void utc_media_recorder_split_n(void);
+static void utc_media_recorder_start_next_take_p(void);
+static void utc_media_recorder_start_next_take_n(void);
+static void utc_media_recorder_set_speculative_realize_p(void);
+static void utc_media_recorder_set_speculative_realize_n(void);
+static void utc_media_recorder_group_prepare_p(void);
+static void utc_media_recorder_group_prepare_n(void);
+static void utc_media_recorder_set_idle_release_timeout_p(void);
+static void utc_media_recorder_set_idle_release_timeout_n(void);
+static void utc_media_recorder_get_start_latency_p(void);
+static void utc_media_recorder_get_start_latency_n(void);
+static void utc_media_recorder_set_auto_resume_p(void);
+static void utc_media_recorder_set_auto_resume_n(void);
+static void utc_media_recorder_set_loop_recording_p(void);
+static void utc_media_recorder_set_loop_recording_n(void);
+static void utc_media_recorder_set_output_cb_p(void);
+static void utc_media_recorder_set_output_cb_n(void);
+static void utc_media_recorder_set_file_preallocation_p(void);
+static void utc_media_recorder_set_file_preallocation_n(void);
+static void utc_media_recorder_set_write_behind_p(void);
+static void utc_media_recorder_set_write_behind_n(void);
+static void utc_media_recorder_set_write_behind_backend_p(void);
+static void utc_media_recorder_set_write_behind_backend_n(void);
+static void utc_media_recorder_attr_set_audio_samplerate_out_of_range_n(void);
+static void utc_media_recorder_attr_set_audio_encoder_bitrate_out_of_range_n(void);
+static void utc_media_recorder_attr_set_audio_channel_out_of_range_n(void);
 
 struct tet_testlist tet_testlist[] = { 
 	{ utc_media_recorder_attr_get_audio_device_p , 1 },
@@ -110,6 +160,53 @@ struct tet_testlist tet_testlist[] = {
 	{ utc_media_recorder_set_filename_n , 2 },
 	{ utc_media_recorder_set_video_encoder_p , 1 },
 	{ utc_media_recorder_set_video_encoder_n , 2 }, 
+	{ utc_media_recorder_attr_commit_p , 1 },
+	{ utc_media_recorder_attr_commit_n , 2 },
+	{ utc_media_recorder_attr_rollback_p , 1 },
+	{ utc_media_recorder_attr_rollback_n , 2 },
+	{ utc_media_recorder_apply_profile_p , 1 },
+	{ utc_media_recorder_apply_profile_n , 2 },
+	{ utc_media_recorder_profile_deserialize_p , 1 },
+	{ utc_media_recorder_profile_deserialize_n , 2 },
+	{ utc_media_recorder_import_config_p , 1 },
+	{ utc_media_recorder_import_config_n , 2 },
+	{ utc_media_recorder_get_supported_audio_encoders_p , 1 },
+	{ utc_media_recorder_get_supported_audio_encoders_n , 2 },
+	{ utc_media_recorder_is_audio_encoder_compatible_p , 1 },
+	{ utc_media_recorder_is_audio_encoder_compatible_n , 2 },
+	{ utc_media_recorder_pool_acquire_p , 1 },
+	{ utc_media_recorder_pool_acquire_n , 2 },
+	{ utc_media_recorder_prepare_async_p , 1 },
+	{ utc_media_recorder_prepare_async_n , 2 },
+	{ utc_media_recorder_commit_async_p , 1 },
+	{ utc_media_recorder_commit_async_n , 2 },
+	{ utc_media_recorder_split_p , 1 },
+	{ utc_media_recorder_split_n , 2 },
+	{ utc_media_recorder_start_next_take_p , 1 },
+	{ utc_media_recorder_start_next_take_n , 2 },
+	{ utc_media_recorder_set_speculative_realize_p , 1 },
+	{ utc_media_recorder_set_speculative_realize_n , 2 },
+	{ utc_media_recorder_group_prepare_p , 1 },
+	{ utc_media_recorder_group_prepare_n , 2 },
+	{ utc_media_recorder_set_idle_release_timeout_p , 1 },
+	{ utc_media_recorder_set_idle_release_timeout_n , 2 },
+	{ utc_media_recorder_get_start_latency_p , 1 },
+	{ utc_media_recorder_get_start_latency_n , 2 },
+	{ utc_media_recorder_set_auto_resume_p , 1 },
+	{ utc_media_recorder_set_auto_resume_n , 2 },
+	{ utc_media_recorder_set_loop_recording_p , 1 },
+	{ utc_media_recorder_set_loop_recording_n , 2 },
+	{ utc_media_recorder_set_output_cb_p , 1 },
+	{ utc_media_recorder_set_output_cb_n , 2 },
+	{ utc_media_recorder_set_file_preallocation_p , 1 },
+	{ utc_media_recorder_set_file_preallocation_n , 2 },
+	{ utc_media_recorder_set_write_behind_p , 1 },
+	{ utc_media_recorder_set_write_behind_n , 2 },
+	{ utc_media_recorder_set_write_behind_backend_p , 1 },
+	{ utc_media_recorder_set_write_behind_backend_n , 2 },
+	{ utc_media_recorder_attr_set_audio_samplerate_out_of_range_n , 2 },
+	{ utc_media_recorder_attr_set_audio_encoder_bitrate_out_of_range_n , 2 },
+	{ utc_media_recorder_attr_set_audio_channel_out_of_range_n , 2 },
 	{ NULL, 0 },
 };
 
@@ -423,3 +520,566 @@ static void utc_media_recorder_set_video_encoder_n(void)
 	dts_check_ne(__func__, ret , RECORDER_ERROR_NONE, "-1 is not allowed");
 }
 
+static void utc_media_recorder_attr_commit_p(void)
+{
+	int ret;
+	int value;
+	ret = recorder_attr_begin(recorder);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_begin");
+	ret = recorder_attr_set_size_limit(recorder, 1212);
+	MY_ASSERT(__func__, ret == 0 , "Fail staging size limit");
+	ret = recorder_attr_set_time_limit(recorder, 10);
+	MY_ASSERT(__func__, ret == 0 , "Fail staging time limit");
+	ret = recorder_attr_commit(recorder, NULL);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_commit");
+	ret = recorder_attr_get_size_limit(recorder, &value);
+	dts_check_eq(__func__, value , 1212, "staged size limit is not applied");
+}
+
+static void utc_media_recorder_attr_commit_n(void)
+{
+	int ret;
+	ret = recorder_attr_commit(recorder, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_STATE, "commit without begin should be fail");
+}
+
+static void utc_media_recorder_attr_rollback_p(void)
+{
+	int ret;
+	int value;
+	recorder_attr_set_size_limit(recorder, 0);
+	ret = recorder_attr_begin(recorder);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_begin");
+	recorder_attr_set_size_limit(recorder, 1212);
+	ret = recorder_attr_rollback(recorder);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_rollback");
+	recorder_attr_get_size_limit(recorder, &value);
+	dts_check_eq(__func__, value , 0, "rolled back size limit is applied");
+}
+
+static void utc_media_recorder_attr_rollback_n(void)
+{
+	int ret;
+	ret = recorder_attr_rollback(NULL);
+	dts_check_ne(__func__, ret , RECORDER_ERROR_NONE, "NULL is not allowed");
+}
+
+static void utc_media_recorder_apply_profile_p(void)
+{
+	int ret;
+	int value;
+	recorder_profile_h profile;
+	ret = recorder_profile_create("utc_voice", &profile);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_profile_create");
+	recorder_profile_set_file_format(profile, RECORDER_FILE_FORMAT_AMR);
+	recorder_profile_set_audio_encoder(profile, RECORDER_AUDIO_CODEC_AMR);
+	recorder_profile_set_size_limit(profile, 2424);
+	ret = recorder_profile_register(profile);
+	recorder_profile_destroy(profile);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_profile_register");
+	ret = recorder_profile_lookup("utc_voice", &profile);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_profile_lookup");
+	ret = recorder_apply_profile(recorder, profile);
+	recorder_profile_destroy(profile);
+	recorder_profile_unregister("utc_voice");
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_apply_profile");
+	recorder_attr_get_size_limit(recorder, &value);
+	dts_check_eq(__func__, value , 2424, "profile size limit is not applied");
+}
+
+static void utc_media_recorder_apply_profile_n(void)
+{
+	int ret;
+	recorder_profile_h profile;
+	recorder_profile_create("utc_video", &profile);
+	recorder_profile_set_video_encoder(profile, RECORDER_VIDEO_CODEC_MPEG4);
+	ret = recorder_apply_profile(recorder, profile);
+	recorder_profile_destroy(profile);
+	dts_check_ne(__func__, ret , RECORDER_ERROR_NONE, "video profile should not be applied to audio recorder");
+}
+
+static void utc_media_recorder_profile_deserialize_p(void)
+{
+	int ret;
+	int size;
+	void *data;
+	char *name;
+	recorder_profile_h profile;
+	recorder_profile_create("utc_serialize", &profile);
+	recorder_profile_set_time_limit(profile, 10);
+	ret = recorder_profile_serialize(profile, &data, &size);
+	recorder_profile_destroy(profile);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_profile_serialize");
+	ret = recorder_profile_deserialize(data, size, &profile);
+	free(data);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_profile_deserialize");
+	recorder_profile_get_name(profile, &name);
+	recorder_profile_destroy(profile);
+	dts_check_eq(__func__, strcmp(name, "utc_serialize"), 0, "profile name is not restored");
+	free(name);
+}
+
+static void utc_media_recorder_profile_deserialize_n(void)
+{
+	int ret;
+	char data[4] = {0,};
+	recorder_profile_h profile;
+	ret = recorder_profile_deserialize(data, sizeof(data), &profile);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "malformed data should be rejected");
+}
+
+static void utc_media_recorder_import_config_p(void)
+{
+	int ret;
+	int size;
+	int value;
+	void *data;
+	recorder_attr_set_time_limit(recorder, 30);
+	ret = recorder_export_config(recorder, &data, &size);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_export_config");
+	recorder_attr_set_time_limit(recorder, 0);
+	ret = recorder_import_config(recorder, data, size);
+	free(data);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_import_config");
+	recorder_attr_get_time_limit(recorder, &value);
+	dts_check_eq(__func__, value , 30, "exported time limit is not restored");
+}
+
+static void utc_media_recorder_import_config_n(void)
+{
+	int ret;
+	char data[16] = {0,};
+	ret = recorder_import_config(recorder, data, sizeof(data));
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "malformed data should be rejected");
+}
+
+static void utc_media_recorder_get_supported_audio_encoders_p(void)
+{
+	int ret;
+	recorder_audio_codec_e codecs[8];
+	int count = 8;
+	ret = recorder_get_supported_audio_encoders(recorder, codecs, &count);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_get_supported_audio_encoders");
+	dts_check_ne(__func__, count , 0, "no supported audio encoder");
+}
+
+static void utc_media_recorder_get_supported_audio_encoders_n(void)
+{
+	int ret;
+	int count = 8;
+	ret = recorder_get_supported_audio_encoders(recorder, NULL, &count);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL array with capacity is not allowed");
+}
+
+static void utc_media_recorder_is_audio_encoder_compatible_p(void)
+{
+	bool ret;
+	ret = recorder_is_audio_encoder_compatible(RECORDER_FILE_FORMAT_AMR, RECORDER_AUDIO_CODEC_AMR);
+	dts_check_eq(__func__, ret , true, "AMR should be stored in AMR file");
+}
+
+static void utc_media_recorder_is_audio_encoder_compatible_n(void)
+{
+	bool ret;
+	ret = recorder_is_audio_encoder_compatible(RECORDER_FILE_FORMAT_WAV, RECORDER_AUDIO_CODEC_AMR);
+	dts_check_eq(__func__, ret , false, "AMR should not be stored in WAV file");
+}
+
+static void utc_media_recorder_pool_acquire_p(void)
+{
+	int ret;
+	recorder_pool_h pool;
+	recorder_h pooled;
+	ret = recorder_pool_create(1, NULL, false, &pool);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_pool_create");
+	ret = recorder_pool_acquire(pool, &pooled);
+	if( ret == 0 )
+		recorder_destroy(pooled);
+	recorder_pool_destroy(pool);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_pool_acquire");
+}
+
+static void utc_media_recorder_pool_acquire_n(void)
+{
+	int ret;
+	recorder_h pooled;
+	ret = recorder_pool_acquire(NULL, &pooled);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static volatile int async_result = -1;
+
+static void _async_completed_cb(recorder_error_e error, void *user_data)
+{
+	async_result = error;
+}
+
+static void utc_media_recorder_prepare_async_p(void)
+{
+	int ret;
+	int i;
+	async_result = -1;
+	ret = recorder_prepare_async(recorder, _async_completed_cb, NULL);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_prepare_async");
+	for( i = 0 ; i < 500 && async_result == -1 ; i++ )
+		usleep(10000);
+	recorder_unprepare(recorder);
+	dts_check_eq(__func__, async_result , RECORDER_ERROR_NONE, "async prepare is not completed");
+}
+
+static void utc_media_recorder_prepare_async_n(void)
+{
+	int ret;
+	ret = recorder_prepare_async(NULL, _async_completed_cb, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void _commit_completed_cb(recorder_error_e error, const char *path, unsigned long long size, void *user_data)
+{
+	async_result = error;
+}
+
+static void utc_media_recorder_commit_async_p(void)
+{
+	int ret;
+	int i;
+	async_result = -1;
+	recorder_set_filename(recorder, "/mnt/nfs/test_async.amr");
+	recorder_prepare(recorder);
+	recorder_start(recorder);
+	sleep(1);
+	ret = recorder_commit_async(recorder, _commit_completed_cb, NULL);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_commit_async");
+	for( i = 0 ; i < 500 && async_result == -1 ; i++ )
+		usleep(10000);
+	recorder_unprepare(recorder);
+	dts_check_eq(__func__, async_result , RECORDER_ERROR_NONE, "async commit is not completed");
+}
+
+static void utc_media_recorder_commit_async_n(void)
+{
+	int ret;
+	ret = recorder_commit_async(NULL, _commit_completed_cb, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void utc_media_recorder_split_p(void)
+{
+	int ret;
+	recorder_set_filename(recorder, "/mnt/nfs/test_split_0.amr");
+	recorder_prepare(recorder);
+	recorder_start(recorder);
+	sleep(1);
+	ret = recorder_split(recorder, "/mnt/nfs/test_split_1.amr");
+	recorder_cancel(recorder);
+	recorder_unprepare(recorder);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_split");
+}
+
+static void utc_media_recorder_split_n(void)
+{
+	int ret;
+	ret = recorder_split(recorder, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void utc_media_recorder_start_next_take_p(void)
+{
+	int ret;
+	recorder_prepare(recorder);
+	ret = recorder_start_next_take(recorder, "/mnt/nfs/test_take_0.amr");
+	if( ret == RECORDER_ERROR_NONE )
+		ret = recorder_start_next_take(recorder, "/mnt/nfs/test_take_1.amr");
+	recorder_cancel(recorder);
+	recorder_unprepare(recorder);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_start_next_take");
+}
+
+static void utc_media_recorder_start_next_take_n(void)
+{
+	int ret;
+	ret = recorder_start_next_take(recorder, "/mnt/nfs/test_take_0.amr");
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_STATE, "not prepared recorder is not allowed");
+}
+
+static void utc_media_recorder_set_speculative_realize_p(void)
+{
+	int ret;
+	recorder_h speculative;
+	recorder_set_speculative_realize(true);
+	ret = recorder_create_audiorecorder(&speculative);
+	recorder_set_speculative_realize(false);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_create_audiorecorder");
+	recorder_set_audio_encoder(speculative, RECORDER_AUDIO_CODEC_AMR);
+	recorder_set_file_format(speculative, RECORDER_FILE_FORMAT_AMR);
+	ret = recorder_prepare(speculative);
+	recorder_unprepare(speculative);
+	recorder_destroy(speculative);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_prepare after speculative realize");
+}
+
+static void utc_media_recorder_set_speculative_realize_n(void)
+{
+	int ret;
+	recorder_h speculative;
+	recorder_set_speculative_realize(true);
+	ret = recorder_create_audiorecorder(&speculative);
+	recorder_set_speculative_realize(false);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_create_audiorecorder");
+	recorder_set_file_format(speculative, RECORDER_FILE_FORMAT_AMR);
+	recorder_set_audio_encoder(speculative, RECORDER_AUDIO_CODEC_AAC);
+	ret = recorder_prepare(speculative);
+	recorder_destroy(speculative);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_OPERATION, "incompatible encoder is not allowed");
+}
+
+static void utc_media_recorder_group_prepare_p(void)
+{
+	int ret;
+	recorder_group_h group;
+	recorder_group_stats_s stats;
+	ret = recorder_group_create(2, NULL, &group);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_group_create");
+	ret = recorder_group_prepare(group);
+	recorder_group_get_stats(group, &stats);
+	recorder_group_destroy(group);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_group_prepare");
+	dts_check_eq(__func__, stats.recording_count + stats.failed_count , 0, "nothing is recording and nothing failed");
+}
+
+static void utc_media_recorder_group_prepare_n(void)
+{
+	int ret;
+	ret = recorder_group_prepare(NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void utc_media_recorder_set_idle_release_timeout_p(void)
+{
+	int ret;
+	recorder_state_e state;
+	recorder_idle_stats_s stats;
+	ret = recorder_set_idle_release_timeout(recorder, 100);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_set_idle_release_timeout");
+	recorder_set_filename(recorder, "/mnt/nfs/test_idle.amr");
+	recorder_prepare(recorder);
+	usleep(500000);
+	recorder_get_state(recorder, &state);
+	ret = recorder_start(recorder);
+	recorder_cancel(recorder);
+	recorder_unprepare(recorder);
+	recorder_set_idle_release_timeout(recorder, 0);
+	recorder_get_idle_release_stats(recorder, &stats);
+	MY_ASSERT(__func__, (state == RECORDER_STATE_READY) , "released recorder must stay READY");
+	dts_check_eq(__func__, stats.reacquire_count , 1, "recorder_start must prepare the released recorder");
+}
+
+static void utc_media_recorder_set_idle_release_timeout_n(void)
+{
+	int ret;
+	ret = recorder_set_idle_release_timeout(recorder, -1);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "negative timeout is not allowed");
+}
+
+static void utc_media_recorder_get_start_latency_p(void)
+{
+	int ret;
+	recorder_start_latency_s latency;
+	recorder_set_filename(recorder, "/mnt/nfs/test_latency.amr");
+	recorder_prepare(recorder);
+	recorder_start(recorder);
+	sleep(1);
+	ret = recorder_get_start_latency(recorder, &latency);
+	recorder_cancel(recorder);
+	recorder_unprepare(recorder);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_get_start_latency");
+	dts_check_ne(__func__, latency.call_time , -1, "recorder_start return is not measured");
+}
+
+static void utc_media_recorder_get_start_latency_n(void)
+{
+	int ret;
+	ret = recorder_get_start_latency(recorder, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void _auto_resumed_cb(recorder_error_e error, const char *filename, int gap, void *user_data)
+{
+}
+
+static void utc_media_recorder_set_auto_resume_p(void)
+{
+	int ret;
+	ret = recorder_set_auto_resumed_cb(recorder, _auto_resumed_cb, NULL);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_set_auto_resumed_cb");
+	ret = recorder_set_auto_resume(recorder, 3000);
+	recorder_set_auto_resume(recorder, 0);
+	recorder_unset_auto_resumed_cb(recorder);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_set_auto_resume");
+}
+
+static void utc_media_recorder_set_auto_resume_n(void)
+{
+	int ret;
+	ret = recorder_set_auto_resume(recorder, -1);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "negative timeout is not allowed");
+}
+
+static void utc_media_recorder_set_loop_recording_p(void)
+{
+	int ret;
+	int count = 0;
+	ret = recorder_set_loop_recording(recorder, 1, 3, "/mnt/nfs/test_loop");
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_set_loop_recording");
+	recorder_prepare(recorder);
+	recorder_start(recorder);
+	sleep(3);
+	ret = recorder_save_loop_recording(recorder, "/mnt/nfs", &count);
+	recorder_cancel(recorder);
+	recorder_unprepare(recorder);
+	recorder_set_loop_recording(recorder, 0, 0, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_save_loop_recording");
+}
+
+static void utc_media_recorder_set_loop_recording_n(void)
+{
+	int ret;
+	ret = recorder_set_loop_recording(recorder, 60, 1, "/mnt/nfs/test_loop");
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "a loop needs at least two segments");
+}
+
+static int output_size = 0;
+
+static void _output_write_cb(const void *data, int size, void *user_data)
+{
+	output_size += size;
+}
+
+static void utc_media_recorder_set_output_cb_p(void)
+{
+	int ret;
+	output_size = 0;
+	recorder_set_file_format(recorder, RECORDER_FILE_FORMAT_AMR);
+	recorder_set_audio_encoder(recorder, RECORDER_AUDIO_CODEC_AMR);
+	ret = recorder_set_output_cb(recorder, _output_write_cb, NULL, NULL);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_set_output_cb");
+	recorder_prepare(recorder);
+	recorder_start(recorder);
+	sleep(1);
+	recorder_commit(recorder);
+	recorder_unprepare(recorder);
+	recorder_unset_output_cb(recorder);
+	dts_check_ne(__func__, output_size , 0, "no output is delivered");
+}
+
+static void utc_media_recorder_set_output_cb_n(void)
+{
+	int ret;
+	ret = recorder_set_output_cb(recorder, NULL, NULL, NULL);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void utc_media_recorder_set_file_preallocation_p(void)
+{
+	int ret;
+	ret = recorder_set_file_preallocation(recorder, true);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_set_file_preallocation");
+	recorder_attr_set_size_limit(recorder, 1024);
+	recorder_set_filename(recorder, "/mnt/nfs/test_prealloc.amr");
+	recorder_prepare(recorder);
+	ret = recorder_start(recorder);
+	sleep(1);
+	recorder_commit(recorder);
+	recorder_unprepare(recorder);
+	recorder_attr_set_size_limit(recorder, 0);
+	recorder_set_file_preallocation(recorder, false);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_start with preallocation");
+}
+
+static void utc_media_recorder_set_file_preallocation_n(void)
+{
+	int ret;
+	ret = recorder_set_file_preallocation(NULL, true);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "NULL is not allowed");
+}
+
+static void utc_media_recorder_set_write_behind_p(void)
+{
+	int ret;
+	ret = recorder_set_write_behind(recorder, 1024, false);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_set_write_behind");
+	recorder_set_output_durability(recorder, RECORDER_DURABILITY_COMMIT, 0);
+	recorder_set_file_format(recorder, RECORDER_FILE_FORMAT_AMR);
+	recorder_set_filename(recorder, "/mnt/nfs/test_write_behind.amr");
+	recorder_prepare(recorder);
+	ret = recorder_start(recorder);
+	sleep(1);
+	recorder_commit(recorder);
+	recorder_unprepare(recorder);
+	recorder_set_output_durability(recorder, RECORDER_DURABILITY_NONE, 0);
+	recorder_set_write_behind(recorder, 0, false);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_start with write behind");
+}
+
+static void utc_media_recorder_set_write_behind_n(void)
+{
+	int ret;
+	ret = recorder_set_write_behind(recorder, 4, false);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "budget smaller than 8KB is not allowed");
+}
+
+static void utc_media_recorder_set_write_behind_backend_p(void)
+{
+	int ret;
+	ret = recorder_set_write_behind_backend(recorder, RECORDER_WRITER_BACKEND_WRITE);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_NONE, "Fail recorder_set_write_behind_backend");
+}
+
+static void utc_media_recorder_set_write_behind_backend_n(void)
+{
+	int ret;
+	ret = recorder_set_write_behind_backend(recorder, -1);
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "invalid backend is not allowed");
+}
+
+static void utc_media_recorder_attr_set_audio_samplerate_out_of_range_n(void)
+{
+	int ret;
+	int min = 0, max = 0;
+	int before = 0, after = 0;
+	ret = recorder_attr_get_audio_samplerate_range(recorder, &min, &max);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_get_audio_samplerate_range");
+	recorder_attr_get_audio_samplerate(recorder, &before);
+	ret = recorder_attr_set_audio_samplerate(recorder, max + 1);
+	recorder_attr_get_audio_samplerate(recorder, &after);
+	MY_ASSERT(__func__, (before == after), "rejected samplerate is applied");
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "samplerate over the range is not allowed");
+}
+
+static void utc_media_recorder_attr_set_audio_encoder_bitrate_out_of_range_n(void)
+{
+	int ret;
+	int min = 0, max = 0;
+	int before = 0, after = 0;
+	ret = recorder_attr_get_audio_encoder_bitrate_range(recorder, &min, &max);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_get_audio_encoder_bitrate_range");
+	recorder_attr_get_audio_encoder_bitrate(recorder, &before);
+	ret = recorder_attr_set_audio_encoder_bitrate(recorder, min - 1);
+	recorder_attr_get_audio_encoder_bitrate(recorder, &after);
+	MY_ASSERT(__func__, (before == after), "rejected bitrate is applied");
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "bitrate under the range is not allowed");
+}
+
+static void utc_media_recorder_attr_set_audio_channel_out_of_range_n(void)
+{
+	int ret;
+	int min = 0, max = 0;
+	int before = 0, after = 0;
+	ret = recorder_attr_get_audio_channel_range(recorder, &min, &max);
+	MY_ASSERT(__func__, ret == 0 , "Fail recorder_attr_get_audio_channel_range");
+	recorder_attr_get_audio_channel(recorder, &before);
+	ret = recorder_attr_set_audio_channel(recorder, max + 1);
+	recorder_attr_get_audio_channel(recorder, &after);
+	MY_ASSERT(__func__, (before == after), "rejected channel count is applied");
+	dts_check_eq(__func__, ret , RECORDER_ERROR_INVALID_PARAMETER, "channel count over the range is not allowed");
+}
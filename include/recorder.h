@@ -44,6 +44,21 @@ extern "C" {
  */
 typedef struct recorder_s *recorder_h;
 
+/**
+ * @brief The handle to recording profile
+ */
+typedef struct recorder_profile_s *recorder_profile_h;
+
+/**
+ * @brief The handle to pool of audio recorders
+ */
+typedef struct recorder_pool_s *recorder_pool_h;
+
+/**
+ * @brief The handle to group of audio recorders
+ */
+typedef struct recorder_group_s *recorder_group_h;
+
 /**
  * @brief  Enumerations of error code for the media recorder.
  */
@@ -147,6 +162,82 @@ typedef enum
 	RECORDER_POLICY_SECURITY /**< Security policy */
 } recorder_policy_e;
 
+/**
+ * @brief Enumerations of the durability policy of the recording file.
+ */
+typedef enum
+{
+	RECORDER_DURABILITY_NONE = 0,	/**< Write back is left to the system */
+	RECORDER_DURABILITY_PERIODIC,	/**< fdatasync() at a fixed interval while recording */
+	RECORDER_DURABILITY_COMMIT,	/**< fsync() when the take is committed */
+} recorder_durability_e;
+
+/**
+ * @brief Enumerations of the backend writing the write-behind buffers to storage.
+ */
+typedef enum
+{
+	RECORDER_WRITER_BACKEND_WRITE = 0,	/**< pwrite() from the write-behind thread of each recorder */
+	RECORDER_WRITER_BACKEND_IO_URING,	/**< io_uring shared by all the recorders of the process */
+} recorder_writer_backend_e;
+
+/**
+ * @brief Aggregated statistics of a recorder group.
+ * @see recorder_group_get_stats()
+ */
+typedef struct
+{
+	int recorder_count;		/**< Number of recorders in the group */
+	int recording_count;		/**< Number of recorders in #RECORDER_STATE_RECORDING or #RECORDER_STATE_PAUSED state */
+	int max_elapsed_time;		/**< Longest recording time among the recorders (milliseconds) */
+	unsigned long long total_file_size;	/**< Sum of the recording file sizes (KB) */
+	int failed_count;		/**< Number of recorders failed in the last group operation */
+	int last_operation_time;	/**< Duration of the last group operation (milliseconds) */
+} recorder_group_stats_s;
+
+/**
+ * @brief Statistics of the idle release policy of a recorder.
+ * @see recorder_get_idle_release_stats()
+ */
+typedef struct
+{
+	int release_count;		/**< Number of times the pipeline has been released */
+	int released_memory;		/**< Estimate of the resident memory given back by the last release, sampled on the whole process around the unrealize (KB) */
+	int reacquire_count;		/**< Number of times recorder_start() prepared a released pipeline again */
+	int last_reacquire_time;	/**< Latency added to recorder_start() by the last re-prepare (milliseconds) */
+	int total_reacquire_time;	/**< Sum of the latencies added by re-prepares (milliseconds) */
+} recorder_idle_stats_s;
+
+/**
+ * @brief Startup latency of the last take, measured from the entry of the function starting it.
+ * @details Times are in microseconds, -1 if the event has not been observed.
+ * @see recorder_get_start_latency()
+ */
+typedef struct
+{
+	int take_count;			/**< Number of takes started successfully */
+	int call_time;			/**< Until the function starting the take returns */
+	int state_changed_time;		/**< Until the core reports #RECORDER_STATE_RECORDING */
+	int first_buffer_time;		/**< Until the first buffer reaches recorder_audio_stream_cb(), only observed if the callback is set */
+	int first_status_time;		/**< Until the first recorder_recording_status_cb() report */
+	int first_sample_time;		/**< The earlier of @a first_buffer_time and @a first_status_time */
+	int worst_first_sample_time;	/**< The longest @a first_sample_time among all takes */
+} recorder_start_latency_s;
+
+/**
+ * @brief Statistics of the write-behind stage, accumulated over all takes.
+ * @see recorder_get_write_behind_stats()
+ */
+typedef struct
+{
+	int buffer_size;		/**< Buffer budget of the last take (bytes) */
+	int high_water;			/**< Most bytes held in the buffers at once (bytes) */
+	int stall_count;		/**< Number of times the muxer waited for a free buffer */
+	int write_count;		/**< Number of writes to storage */
+	int sync_count;			/**< Number of fdatasync() or fsync() calls */
+	unsigned long long bytes_written;	/**< Bytes written to storage */
+} recorder_write_behind_stats_s;
+
 /**
  * @}
 */
@@ -212,6 +303,38 @@ typedef void (*recorder_state_changed_cb)(recorder_state_e previous , recorder_s
  */
 typedef void (*recorder_interrupted_cb)(recorder_policy_e policy, recorder_state_e previous, recorder_state_e current, void *user_data);
 
+/**
+ * @brief	Called when the auto resume after a sound policy interruption is over.
+ *
+ * @param[in] error	#RECORDER_ERROR_NONE if recording is resumed, otherwise the error of the last attempt
+ * @param[in] filename	The new segment recording continues into, @c NULL if it continues in the same file
+ * @param[in] gap	The time recording was interrupted (milliseconds)
+ * @param[in] user_data	The user data passed from the callback registration function
+ * @remarks The callback is invoked on a thread of the library.
+ * @see	recorder_set_auto_resume()
+ * @see	recorder_set_auto_resumed_cb()
+ */
+typedef void (*recorder_auto_resumed_cb)(recorder_error_e error, const char *filename, int gap, void *user_data);
+
+/**
+ * @brief	Called with the bytes of the recording file when the output is delivered through callbacks.
+ *
+ * @param[in] data	The bytes in file order
+ * @param[in] size	The size of @a data in bytes
+ * @param[in] user_data	The user data passed from the callback registration function
+ * @remarks The callback is invoked on a thread of the library. Recording is slowed down while it does not return.
+ * @see	recorder_set_output_cb()
+ */
+typedef void (*recorder_output_write_cb)(const void *data, int size, void *user_data);
+
+/**
+ * @brief	Called when all the bytes of a recording file have been delivered.
+ *
+ * @param[in] user_data	The user data passed from the callback registration function
+ * @see	recorder_set_output_cb()
+ */
+typedef void (*recorder_output_flush_cb)(void *user_data);
+
 /**
  * @brief Called when audio stream data was delivering just before storing in record file.
  * @remarks
@@ -251,6 +374,27 @@ typedef void (*recorder_audio_stream_cb)(void* stream, int size, audio_sample_ty
  */
 typedef void (*recorder_error_cb)(recorder_error_e error, recorder_state_e current_state, void *user_data);
 
+/**
+ * @brief Called when an asynchronous operation is completed.
+ * @param[in] error The result of the operation, #RECORDER_ERROR_NONE on success
+ * @param[in] user_data The user data passed from the function which started the operation
+ * @remarks The callback is invoked on a thread of the library, not on the caller thread.
+ * @see	recorder_prepare_async()
+ * @see	recorder_unprepare_async()
+ */
+typedef void (*recorder_async_completed_cb)(recorder_error_e error, void *user_data);
+
+/**
+ * @brief Called when the recording file is finalized by recorder_commit_async().
+ * @param[in] error The result of the commit, #RECORDER_ERROR_NONE on success
+ * @param[in] path The path of the recording file, can be @c NULL if the recorder has no target file
+ * @param[in] size The size of the recording file in bytes, @c 0 on failure
+ * @param[in] user_data The user data passed from recorder_commit_async()
+ * @remarks The callback is invoked on a thread of the library, not on the caller thread.
+ * @see	recorder_commit_async()
+ */
+typedef void (*recorder_commit_completed_cb)(recorder_error_e error, const char *path, unsigned long long size, void *user_data);
+
 
  /**
  * @}
@@ -360,7 +504,8 @@ int recorder_destroy(recorder_h recorder);
 /**
  * @brief  Prepares the media recorder for recording
  * @remarks	Before calling the function, it is required to set audio encoder (recorder_set_audio_encoder()),
- * video encoder(recorder_set_video_encoder()), file format (recorder_set_file_format()) with proper value.
+ * video encoder(recorder_set_video_encoder()), file format (recorder_set_file_format()) with proper value.\n
+ * If the encoders can not be stored in the file format, #RECORDER_ERROR_INVALID_OPERATION is returned before the pipeline is built.
  * @param[in]	recorder	The handle to media recorder
  * @return	0 on success, otherwise a negative error value.
  * @retval #RECORDER_ERROR_NONE Successful
@@ -398,10 +543,62 @@ int recorder_prepare(recorder_h recorder);
  */
 int recorder_unprepare(recorder_h recorder);
 
+/**
+ * @brief  Prepares the media recorder on a thread of the library.
+ * @remarks This function returns right away, and @a callback is invoked with the result of recorder_prepare().\n
+ * Only one asynchronous operation can be in progress for a recorder.\n
+ * A queued operation can be cancelled by recorder_cancel_async() until it starts. Once started, it runs to completion and @a callback is always invoked.\n
+ * recorder_destroy() cancels a queued operation, or waits for the running one.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	callback	The callback function to be invoked on completion, can be @c NULL
+ * @param[in]	user_data	The user data to be passed to the callback function
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Another asynchronous operation is in progress
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The operation can not be queued
+ * @see	recorder_prepare()
+ * @see	recorder_cancel_async()
+ */
+int recorder_prepare_async(recorder_h recorder, recorder_async_completed_cb callback, void *user_data);
+
+/**
+ * @brief  Unprepares the media recorder on a thread of the library.
+ * @remarks This function returns right away, and @a callback is invoked with the result of recorder_unprepare().\n
+ * The rules of recorder_prepare_async() apply.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	callback	The callback function to be invoked on completion, can be @c NULL
+ * @param[in]	user_data	The user data to be passed to the callback function
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Another asynchronous operation is in progress
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The operation can not be queued
+ * @see	recorder_unprepare()
+ * @see	recorder_cancel_async()
+ */
+int recorder_unprepare_async(recorder_h recorder, recorder_async_completed_cb callback, void *user_data);
+
+/**
+ * @brief  Cancels the queued asynchronous operation.
+ * @remarks The callback of a cancelled operation is not invoked.\n
+ * An operation which already started can not be cancelled.
+ * @param[in]	recorder	The handle to media recorder
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful, the operation will not run
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE No operation is queued, or the operation already started
+ * @see	recorder_prepare_async()
+ * @see	recorder_unprepare_async()
+ * @see	recorder_commit_async()
+ */
+int recorder_cancel_async(recorder_h recorder);
+
 
 /**
  * @brief  Starts recording
- * @remarks If file path has been set to existing file, this file is removed automatically and updated by new one.
+ * @remarks If file path has been set to existing file, this file is removed automatically and updated by new one.\n
+ * While a file is still finalized by recorder_commit_async(), this function blocks until the commit is over.
  * @param[in]	recorder	The handle to media recorder
  * @return	0 on success, otherwise a negative error value.
  * @retval #RECORDER_ERROR_NONE Successful
@@ -456,6 +653,313 @@ int recorder_pause(recorder_h recorder);
  */
 int recorder_commit(recorder_h recorder);
 
+/**
+ * @brief  Stops recording and finalizes the recording file on a thread of the library.
+ * @remarks This function returns right away, and @a callback is invoked with the path and the size of the finished file.\n
+ * The next take can be configured right after this function, attribute setters keep the values in the recorder
+ * until the file is finalized, and recorder_start() blocks until the commit is over before starting the next take.\n
+ * Values are checked against the supported ranges when they are set, but they reach the core only when the commit is over.
+ * If the core rejects one of them then, the error is returned by the next attribute setter or by recorder_start(),
+ * whichever applies the values first, and none of the deferred values is applied.\n
+ * Getters return the values of the finishing take until then.\n
+ * The rules of recorder_prepare_async() apply to cancellation and to recorder_destroy().
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	callback	The callback function to be invoked on completion, can be @c NULL
+ * @param[in]	user_data	The user data to be passed to the callback function
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Another asynchronous operation is in progress
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The operation can not be queued
+ * @pre The recorder state must be #RECORDER_STATE_RECORDING or #RECORDER_STATE_PAUSED.
+ * @see	recorder_commit()
+ * @see	recorder_cancel_async()
+ */
+int recorder_commit_async(recorder_h recorder, recorder_commit_completed_cb callback, void *user_data);
+
+/**
+ * @brief  Closes the current recording file and continues recording into a new one.
+ * @remarks This is recorder_commit() followed by recording into @a next_filename, without unpreparing the pipeline.
+ * The audio produced while the current file is finalized is not recorded.\n
+ * A paused recorder stays paused on the new file.\n
+ * The current file is finalized before @a next_filename is opened. If the next take can not be started then,
+ * an error is returned and the recorder state is #RECORDER_STATE_READY.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	next_filename	The path of the next recording file
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @pre The recorder state must be #RECORDER_STATE_RECORDING or #RECORDER_STATE_PAUSED.
+ * @post The recorder state is the same as before on success, #RECORDER_STATE_READY if the next take could not be started.
+ * @see	recorder_commit()
+ * @see	recorder_set_filename()
+ */
+int recorder_split(recorder_h recorder, const char *next_filename);
+
+/**
+ * @brief  Starts the next take into @a filename without tearing down the prepared pipeline.
+ * @remarks In #RECORDER_STATE_READY, the target file is changed and recording starts.\n
+ * In #RECORDER_STATE_RECORDING or #RECORDER_STATE_PAUSED, the current take is committed first, like recorder_commit(),
+ * and the audio produced meanwhile is not recorded. If the next take can not be started after that commit,
+ * an error is returned and the recorder state is #RECORDER_STATE_READY.\n
+ * This function never prepares the recorder. If the pipeline has been released, for example by a sound policy interruption,
+ * #RECORDER_ERROR_INVALID_STATE is returned and recorder_prepare() must be called again.
+ * Only a pipeline released by the idle policy is prepared again, see recorder_set_idle_release_timeout().\n
+ * A pending recorder_commit_async() is waited for.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	filename	The path of the recording file of the next take
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The recorder is not prepared
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @pre The recorder state must be #RECORDER_STATE_READY, #RECORDER_STATE_RECORDING or #RECORDER_STATE_PAUSED.
+ * @post The recorder state will be #RECORDER_STATE_RECORDING, or #RECORDER_STATE_READY on failure.
+ * @see	recorder_start()
+ * @see	recorder_split()
+ */
+int recorder_start_next_take(recorder_h recorder, const char *filename);
+
+/**
+ * @brief  Sets the time after which an idle audio recorder releases its pipeline.
+ * @remarks A recorder staying in #RECORDER_STATE_READY longer than @a timeout releases its pipeline, buffers and device.\n
+ * The attributes are kept and the state is still reported as #RECORDER_STATE_READY,
+ * recorder_state_changed_cb() is not invoked for the release nor for the prepare which follows.
+ * The next recorder_start() prepares the recorder again, and the added latency is reported by recorder_get_idle_release_stats().\n
+ * The timeout is disabled by default.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	timeout	The idle time in milliseconds, @c 0 to keep the pipeline
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The recorder is a video recorder
+ * @see	recorder_get_idle_release_timeout()
+ * @see	recorder_get_idle_release_stats()
+ */
+int recorder_set_idle_release_timeout(recorder_h recorder, int timeout);
+
+/**
+ * @brief  Gets the time after which an idle audio recorder releases its pipeline.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[out]	timeout	The idle time in milliseconds, @c 0 if disabled
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_set_idle_release_timeout()
+ */
+int recorder_get_idle_release_timeout(recorder_h recorder, int *timeout);
+
+/**
+ * @brief  Gets the statistics of the idle release policy.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[out]	stats	The statistics
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_set_idle_release_timeout()
+ */
+int recorder_get_idle_release_stats(recorder_h recorder, recorder_idle_stats_s *stats);
+
+/**
+ * @brief  Gets the startup latency of the last take.
+ * @remarks Takes are started by recorder_start(), recorder_start_next_take() and recorder_split().
+ * @param[in]	recorder	The handle to media recorder
+ * @param[out]	latency	The latency breakdown
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_start()
+ */
+int recorder_get_start_latency(recorder_h recorder, recorder_start_latency_s *latency);
+
+/**
+ * @brief  Enables loop recording, which keeps only the last segments of a recording.
+ * @remarks recorder_start() records into "<prefix>_<sequence><extension>" files of @a duration seconds each.
+ * When a segment is full, it is committed and recording continues into the next one, see recorder_split().
+ * The audio produced during the switch is not recorded.
+ * The oldest segments beyond @a count are deleted in the background.\n
+ * The time limit of the recorder is used for the segment duration. recorder_recording_limit_reached_cb() is only invoked for it
+ * when the switch to the next segment can not be scheduled, recording then stops as without loop recording.
+ * The file name set by recorder_set_filename() is not used.\n
+ * Setting @a duration to @c 0 disables loop recording and the time limit, existing segments are kept on disk.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	duration	The duration of a segment in seconds, @c 0 to disable
+ * @param[in]	count	The number of segments kept, at least 2, including the one being recorded
+ * @param[in]	prefix	The path prefix of the segment files
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @pre The recorder state must be #RECORDER_STATE_CREATED or #RECORDER_STATE_READY.
+ * @see	recorder_save_loop_recording()
+ * @see	recorder_attr_set_time_limit()
+ */
+int recorder_set_loop_recording(recorder_h recorder, int duration, int count, const char *prefix);
+
+/**
+ * @brief  Preserves the current window of a loop recording.
+ * @remarks The segment being recorded is closed first and recording continues into a new one.
+ * Every complete segment of the window is then hard linked into @a directory, which must be on the same file system.\n
+ * Segments are not rotated or deleted while they are being saved.\n
+ * A segment already saved into @a directory is counted again, but another file of the same name is an error and is not replaced.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	directory	The directory to save the segments into
+ * @param[out]	count	The number of saved segments, can be @c NULL
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Loop recording is disabled
+ * @retval #RECORDER_ERROR_INVALID_OPERATION A segment can not be saved, or @a directory has another file of the same name
+ * @see	recorder_set_loop_recording()
+ */
+int recorder_save_loop_recording(recorder_h recorder, const char *directory, int *count);
+
+/**
+ * @brief  Delivers the recording file through callbacks instead of writing it to a file.
+ * @remarks The container bytes are delivered in order while recording, without being written to storage.
+ * @a flush_cb is invoked when recorder_commit() or recorder_cancel() ends the take.\n
+ * Bytes can not be rewritten, so only #RECORDER_FILE_FORMAT_AMR and #RECORDER_FILE_FORMAT_ADTS can be delivered,
+ * recorder_start() fails with #RECORDER_ERROR_INVALID_OPERATION for other formats.
+ * Use recorder_set_output_fd() with a seekable descriptor for other formats.\n
+ * recorder_split() and recorder_start_next_take() are not supported with output callbacks.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	write_cb	The callback receiving the bytes
+ * @param[in]	flush_cb	The callback invoked at the end of each take, can be @c NULL
+ * @param[in]	user_data	The user data to be passed to the callback functions
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @pre The recorder state must be #RECORDER_STATE_CREATED or #RECORDER_STATE_READY.
+ * @see	recorder_unset_output_cb()
+ */
+int recorder_set_output_cb(recorder_h recorder, recorder_output_write_cb write_cb, recorder_output_flush_cb flush_cb, void *user_data);
+
+/**
+ * @brief  Writes the recording file to the file set by recorder_set_filename() again.
+ * @param[in]	recorder	The handle to media recorder
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @pre The recorder state must be #RECORDER_STATE_CREATED or #RECORDER_STATE_READY.
+ * @see	recorder_set_output_cb()
+ */
+int recorder_unset_output_cb(recorder_h recorder);
+
+/**
+ * @brief  Writes the recording file to an open file descriptor.
+ * @remarks The descriptor is used in place of the file set by recorder_set_filename(), and must stay open until the take is over.\n
+ * A pipe or a socket can only carry #RECORDER_FILE_FORMAT_AMR and #RECORDER_FILE_FORMAT_ADTS, other formats need a seekable descriptor.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	fd	The writable file descriptor
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter or @a fd is not writable
+ * @see	recorder_set_filename()
+ */
+int recorder_set_output_fd(recorder_h recorder, int fd);
+
+/**
+ * @brief  Enables or disables the preallocation of the recording file.
+ * @remarks When a take starts, storage is reserved for the size limit, or if no size limit is set,
+ * for the encoder bitrates over the time limit. Nothing is reserved without limits.\n
+ * The file grows into the reserved space instead of being extended by small appends, and the unused space
+ * is released by recorder_commit() or recorder_cancel().\n
+ * If the storage can not hold the reservation, recorder_start() fails with #RECORDER_ERROR_INVALID_OPERATION.\n
+ * The reservation is best effort : if the recorder opens the file after the check, the reserved space is given back and the file grows as usual.\n
+ * Output to a file descriptor or to callbacks is not preallocated. The preallocation is disabled by default.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	enable	@c true to enable, @c false to disable
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_attr_set_size_limit()
+ * @see	recorder_attr_set_time_limit()
+ */
+int recorder_set_file_preallocation(recorder_h recorder, bool enable);
+
+/**
+ * @brief  Checks whether the preallocation of the recording file is enabled.
+ * @param[in]	recorder	The handle to media recorder
+ * @return	@c true if enabled, @c false otherwise
+ * @see	recorder_set_file_preallocation()
+ */
+bool recorder_is_file_preallocation_enabled(recorder_h recorder);
+
+/**
+ * @brief  Enables or disables the write-behind stage between the muxer and the recording file.
+ * @remarks The muxer writes into library buffers and a library thread writes them to storage in large aligned blocks,
+ * so a slow storage only stalls recording once the buffer budget is full.\n
+ * With @a direct_io, the file is opened with O_DIRECT and bypasses the page cache. It is opened normally if the file system refuses O_DIRECT.\n
+ * The muxer can not seek in the buffers, so only #RECORDER_FILE_FORMAT_AMR and #RECORDER_FILE_FORMAT_ADTS go through the stage.
+ * Other formats, output callbacks, file descriptors and loop recording are written directly, the setting has no effect on them.\n
+ * If storage refuses a write, recorder_error_cb() is invoked with #RECORDER_ERROR_INVALID_OPERATION, the rest of the take is dropped
+ * and recorder_commit() returns #RECORDER_ERROR_INVALID_OPERATION, as does recorder_commit_completed_cb() of recorder_commit_async().\n
+ * The write-behind stage is disabled by default.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	buffer_kbyte	The buffer budget in kilobytes, at least 8, or 0 to disable
+ * @param[in]	direct_io	@c true to bypass the page cache
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @pre The recorder state must be #RECORDER_STATE_CREATED or #RECORDER_STATE_READY.
+ * @see	recorder_set_output_durability()
+ * @see	recorder_get_write_behind_stats()
+ */
+int recorder_set_write_behind(recorder_h recorder, int buffer_kbyte, bool direct_io);
+
+/**
+ * @brief  Sets when the recording file is flushed to storage.
+ * @remarks #RECORDER_DURABILITY_PERIODIC needs the write-behind stage, the bytes still in the buffer being filled are not covered.
+ * Both policies flush the file when the take ends.\n
+ * #RECORDER_DURABILITY_COMMIT makes recorder_commit() return only once the file is on storage.\n
+ * The policy is #RECORDER_DURABILITY_NONE by default.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	policy	The durability policy
+ * @param[in]	interval	The interval of #RECORDER_DURABILITY_PERIODIC in milliseconds, ignored by other policies
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @pre The recorder state must be #RECORDER_STATE_CREATED or #RECORDER_STATE_READY.
+ * @see	recorder_set_write_behind()
+ */
+int recorder_set_output_durability(recorder_h recorder, recorder_durability_e policy, int interval);
+
+/**
+ * @brief  Selects how the write-behind buffers are written to storage.
+ * @remarks With #RECORDER_WRITER_BACKEND_IO_URING, the writes of all the recorders of the process are batched
+ * into shared io_uring submissions, and the buffers are registered with the kernel when it allows it.
+ * A write refused by io_uring is done again with pwrite().\n
+ * io_uring is only available if the library is built with the USE_IO_URING option and the kernel supports it.\n
+ * The backend is #RECORDER_WRITER_BACKEND_WRITE by default.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[in]	backend	The writer backend
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION io_uring is not available
+ * @pre The recorder state must be #RECORDER_STATE_CREATED or #RECORDER_STATE_READY.
+ * @see	recorder_set_write_behind()
+ */
+int recorder_set_write_behind_backend(recorder_h recorder, recorder_writer_backend_e backend);
+
+/**
+ * @brief  Gets the statistics of the write-behind stage.
+ * @param[in]	recorder	The handle to media recorder
+ * @param[out]	stats	The statistics
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_set_write_behind()
+ */
+int recorder_get_write_behind_stats(recorder_h recorder, recorder_write_behind_stats_s *stats);
+
 
 /**
  * @brief  Cancels recording.
@@ -580,6 +1084,52 @@ int recorder_get_file_format(recorder_h recorder, recorder_file_format_e *format
  */
 int recorder_foreach_supported_file_format(recorder_h recorder, recorder_supported_file_format_cb callback, void *user_data);
 
+/**
+ * @brief Gets all file formats supported by recorder in one call.
+ * @remarks @a formats is filled with at most @a count values, and @a count is set to the number of supported values.\n
+ * If the returned @a count is larger than the given one, call again with a larger array.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] formats The array to receive the supported values, can be @c NULL if @a count is @c 0
+ * @param[in,out] count The capacity of @a formats as input, the number of supported values as output
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_foreach_supported_file_format()
+ */
+int recorder_get_supported_file_formats(recorder_h recorder, recorder_file_format_e *formats, int *count);
+
+/**
+ * @brief  Sets the file used to keep supported capabilities across processes.
+ * @remarks Supported file formats and encoders of audio recorders are queried once per process and shared by all handles.
+ * Those of video recorders depend on the camera device, and are queried once per recorder.\n
+ * If a cache file is set, audio capabilities stored by a previous process are reused as long as the recorder core library is not changed,
+ * and newly queried capabilities are written back to the file.\n
+ * By default no cache file is used. Setting @c NULL disables the cache file.
+ * @param[in] path The path of the cache file
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @see recorder_foreach_supported_file_format()
+ * @see recorder_foreach_supported_audio_encoder()
+ * @see recorder_foreach_supported_video_encoder()
+ */
+int recorder_set_capability_cache_path(const char *path);
+
+/**
+ * @brief  Enables or disables the speculative realize of new audio recorders.
+ * @remarks If enabled, recorder_create_audiorecorder() starts building the recording pipeline in the background,
+ * and a later recorder_prepare() only waits for what is left.
+ * If the background build has not started yet, recorder_prepare() builds the pipeline itself instead of waiting for it.\n
+ * Changing the file format, an encoder, the sample rate, the channel count or the audio device before recorder_prepare()
+ * makes recorder_prepare() build the pipeline again with the new values.\n
+ * The setting applies to recorders created afterwards, in the whole process. It is disabled by default.
+ * @param[in] enable @c true to enable, @c false to disable
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @see recorder_create_audiorecorder()
+ * @see recorder_prepare()
+ */
+int recorder_set_speculative_realize(bool enable);
+
 /**
  * @}
 */
@@ -642,6 +1192,20 @@ int recorder_get_audio_encoder(recorder_h recorder, recorder_audio_codec_e *code
  */
 int recorder_foreach_supported_audio_encoder(recorder_h recorder, recorder_supported_audio_encoder_cb callback, void *user_data);
 
+/**
+ * @brief Gets all audio encoders supported by recorder in one call.
+ * @remarks @a codecs is filled with at most @a count values, and @a count is set to the number of supported values.\n
+ * If the returned @a count is larger than the given one, call again with a larger array.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] codecs The array to receive the supported values, can be @c NULL if @a count is @c 0
+ * @param[in,out] count The capacity of @a codecs as input, the number of supported values as output
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_foreach_supported_audio_encoder()
+ */
+int recorder_get_supported_audio_encoders(recorder_h recorder, recorder_audio_codec_e *codecs, int *count);
+
 /**
  * @}
 */
@@ -703,14 +1267,89 @@ int recorder_get_video_encoder(recorder_h recorder, recorder_video_codec_e *code
  */
 int recorder_foreach_supported_video_encoder(recorder_h recorder, recorder_supported_video_encoder_cb callback, void *user_data);
 
- /**
- * @}
-*/
-
 /**
- * @addtogroup CAPI_MEDIA_RECORDER_MODULE
- * @{
- */
+ * @brief Gets all video encoders supported by recorder in one call.
+ * @remarks @a codecs is filled with at most @a count values, and @a count is set to the number of supported values.\n
+ * If the returned @a count is larger than the given one, call again with a larger array.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] codecs The array to receive the supported values, can be @c NULL if @a count is @c 0
+ * @param[in,out] count The capacity of @a codecs as input, the number of supported values as output
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_foreach_supported_video_encoder()
+ */
+int recorder_get_supported_video_encoders(recorder_h recorder, recorder_video_codec_e *codecs, int *count);
+
+/**
+ * @brief Checks whether the audio codec can be stored in the file format.
+ * @remarks #RECORDER_AUDIO_CODEC_DISABLE is compatible with all file formats.\n
+ * This function checks the combination only, use recorder_foreach_supported_audio_encoder() to check the device support.
+ * @param[in] format The file format
+ * @param[in] codec The audio codec
+ * @return @c true if the combination is valid, otherwise @c false
+ * @see	recorder_foreach_compatible_audio_encoder()
+ */
+bool recorder_is_audio_encoder_compatible(recorder_file_format_e format, recorder_audio_codec_e codec);
+
+/**
+ * @brief Checks whether the video codec can be stored in the file format.
+ * @remarks This function checks the combination only, use recorder_foreach_supported_video_encoder() to check the device support.
+ * @param[in] format The file format
+ * @param[in] codec The video codec
+ * @return @c true if the combination is valid, otherwise @c false
+ * @see	recorder_foreach_compatible_video_encoder()
+ */
+bool recorder_is_video_encoder_compatible(recorder_file_format_e format, recorder_video_codec_e codec);
+
+/**
+ * @brief Retrieves the supported file formats which can store the current encoders of the recorder.
+ * @remarks The video encoder is considered only in video recorder.
+ * @param[in] recorder The handle to media recorder
+ * @param[in] callback The iteration callback
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post  This function invokes recorder_supported_file_format_cb() repeatly to retrieve each compatible file format.
+ * @see	recorder_foreach_supported_file_format()
+ */
+int recorder_foreach_compatible_file_format(recorder_h recorder, recorder_supported_file_format_cb callback, void *user_data);
+
+/**
+ * @brief Retrieves the supported audio encoders which can be stored in the current file format of the recorder.
+ * @param[in] recorder The handle to media recorder
+ * @param[in] callback The iteration callback
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post  This function invokes recorder_supported_audio_encoder_cb() repeatly to retrieve each compatible audio encoder.
+ * @see	recorder_foreach_supported_audio_encoder()
+ */
+int recorder_foreach_compatible_audio_encoder(recorder_h recorder, recorder_supported_audio_encoder_cb callback, void *user_data);
+
+/**
+ * @brief Retrieves the supported video encoders which can be stored in the current file format of the recorder.
+ * @param[in] recorder The handle to media recorder
+ * @param[in] callback The iteration callback
+ * @param[in] user_data	The user data to be passed to the callback function
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post  This function invokes recorder_supported_video_encoder_cb() repeatly to retrieve each compatible video encoder.
+ * @see	recorder_foreach_supported_video_encoder()
+ */
+int recorder_foreach_compatible_video_encoder(recorder_h recorder, recorder_supported_video_encoder_cb callback, void *user_data);
+
+ /**
+ * @}
+*/
+
+/**
+ * @addtogroup CAPI_MEDIA_RECORDER_MODULE
+ * @{
+ */
 
 /**
  * @brief  Registers the callback function that will be invoked when the recorder state changes.
@@ -766,6 +1405,54 @@ int recorder_set_interrupted_cb(recorder_h recorder, recorder_interrupted_cb cal
  */
 int recorder_unset_interrupted_cb(recorder_h recorder);
 
+/**
+ * @brief	Sets the auto resume policy after sound policy interruptions.
+ * @remarks When recording is interrupted by the sound policy, the prepared pipeline is kept and recording is resumed
+ * in the background until @a timeout expires.\n
+ * A paused recording continues in the same file. If the recording file has been closed, recording continues
+ * into a new segment named after it, e.g. "rec_1.amr" for "rec.amr". A released pipeline is prepared again first.\n
+ * Functions changing the recorder state, such as recorder_start(), recorder_commit(), recorder_cancel(), recorder_unprepare()
+ * and recorder_destroy(), stop a resume in progress and wait for it first.\n
+ * recorder_auto_resumed_cb() is invoked once the resume is over, it can call any of them.\n
+ * The policy is disabled by default.
+ * @param[in]	recorder	The handle to the recorder
+ * @param[in]	timeout	The time to retry in milliseconds, @c 0 to disable
+ * @return	  0 on success, otherwise a negative error value.
+ * @retval    #RECORDER_ERROR_NONE Successful
+ * @retval    #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_set_auto_resumed_cb()
+ * @see	recorder_set_interrupted_cb()
+ */
+int recorder_set_auto_resume(recorder_h recorder, int timeout);
+
+/**
+ * @brief	Registers a callback function to be invoked when the auto resume is over.
+ *
+ * @param[in]	recorder	The handle to the recorder
+ * @param[in]	callback	The callback function to register
+ * @param[in]	user_data	The user data to be passed to the callback function
+ * @return	  0 on success, otherwise a negative error value.
+ * @retval    #RECORDER_ERROR_NONE Successful
+ * @retval    #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post	recorder_auto_resumed_cb() will be invoked
+ *
+ * @see	recorder_unset_auto_resumed_cb()
+ * @see	recorder_set_auto_resume()
+ */
+int recorder_set_auto_resumed_cb(recorder_h recorder, recorder_auto_resumed_cb callback, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ *
+ * @param[in]	recorder	The handle to the recorder
+ * @return	  0 on success, otherwise a negative error value.
+ * @retval    #RECORDER_ERROR_NONE Successful
+ * @retval    #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ *
+ * @see     recorder_set_auto_resumed_cb()
+ */
+int recorder_unset_auto_resumed_cb(recorder_h recorder);
+
 /**
  * @brief	Registers a callback function to be called when audio stream data was delivering
  *
@@ -1013,6 +1700,20 @@ int recorder_attr_set_audio_samplerate(recorder_h recorder, int samplerate);
  */
 int recorder_attr_get_audio_samplerate(recorder_h recorder, int *samplerate);
 
+/**
+ * @brief Gets the supported range of the audio sampling rate.
+ * @remarks If the recorder supports only some values in the range, @a min and @a max are the smallest and the largest of them.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] min The minimum value
+ * @param[out] max The maximum value
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The range is not provided by the recorder
+ * @see	recorder_attr_set_audio_samplerate()
+ */
+int recorder_attr_get_audio_samplerate_range(recorder_h recorder, int *min, int *max);
+
 
 /**
  * @brief  Sets the bitrate of audio encoder.
@@ -1065,6 +1766,34 @@ int recorder_attr_get_audio_encoder_bitrate(recorder_h recorder, int *bitrate);
  */
 int recorder_attr_get_video_encoder_bitrate(recorder_h recorder, int *bitrate);
 
+/**
+ * @brief Gets the supported range of the audio encoder bitrate.
+ * @remarks If the recorder supports only some values in the range, @a min and @a max are the smallest and the largest of them.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] min The minimum value
+ * @param[out] max The maximum value
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The range is not provided by the recorder
+ * @see	recorder_attr_set_audio_encoder_bitrate()
+ */
+int recorder_attr_get_audio_encoder_bitrate_range(recorder_h recorder, int *min, int *max);
+
+/**
+ * @brief Gets the supported range of the video encoder bitrate.
+ * @remarks If the recorder supports only some values in the range, @a min and @a max are the smallest and the largest of them.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] min The minimum value
+ * @param[out] max The maximum value
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The range is not provided by the recorder
+ * @see	recorder_attr_set_video_encoder_bitrate()
+ */
+int recorder_attr_get_video_encoder_bitrate_range(recorder_h recorder, int *min, int *max);
+
 
 
 /**
@@ -1150,6 +1879,20 @@ int recorder_attr_set_audio_channel(recorder_h recorder, int channel_count);
  */
 int recorder_attr_get_audio_channel(recorder_h recorder, int *channel_count);
 
+/**
+ * @brief Gets the supported range of the number of audio channel.
+ * @remarks If the recorder supports only some values in the range, @a min and @a max are the smallest and the largest of them.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] min The minimum value
+ * @param[out] max The maximum value
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_OPERATION The range is not provided by the recorder
+ * @see	recorder_attr_set_audio_channel()
+ */
+int recorder_attr_get_audio_channel_range(recorder_h recorder, int *min, int *max);
+
 /**
  * @brief Sets the orientation of video recording data
  * @remarks
@@ -1176,6 +1919,511 @@ int recorder_attr_set_recording_orientation(recorder_h recorder, recorder_rotati
  */
 int recorder_attr_get_recording_orientation(recorder_h recorder, recorder_rotation_e *orientation);
 
+/**
+ * @brief  Begins an attribute transaction.
+ * @remarks After this function, attribute setters (recorder_attr_set_xxx(), recorder_set_file_format(), recorder_set_filename(),
+ * recorder_set_audio_encoder() and recorder_set_video_encoder()) only check their parameters and stage the values in the handle.\n
+ * The staged values are applied to the recorder together by recorder_attr_commit() or discarded by recorder_attr_rollback().\n
+ * Getters keep returning the values applied before the transaction.\n
+ * If recorder_commit_async() is in progress, this function waits for it and then applies the values set meanwhile before the transaction is opened.
+ * If they are rejected, the error is returned and no transaction is opened.
+ * @param[in] recorder The handle to media recorder
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE A transaction is already opened, or a value set during recorder_commit_async() can not be applied in the current state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @see	recorder_attr_commit()
+ * @see	recorder_attr_rollback()
+ */
+int recorder_attr_begin(recorder_h recorder);
+
+/**
+ * @brief  Applies all attributes staged since recorder_attr_begin() in one batch.
+ * @remarks The staged attributes are passed to the core in a single call, which checks all of them before applying any.\n
+ * The transaction is closed whether or not the attributes are applied.\n
+ * If applying fails, @a error_attribute is set to the name of the attribute rejected by the recorder, and must be released with @c free() by you.\n
+ * The staged file format and encoders are checked together, and an incompatible combination is rejected with #RECORDER_ERROR_INVALID_PARAMETER.
+ * @a error_attribute is then the staged one of the two, or the encoder if both are staged.\n
+ * If recorder_commit_async() is in progress, this function waits for it before applying the staged attributes.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] error_attribute The name of the rejected attribute, or @c NULL if the caller is not interested
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE No transaction is opened, or an attribute can not be changed in the current state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @pre A transaction must be opened by recorder_attr_begin()
+ * @see	recorder_attr_begin()
+ * @see	recorder_attr_rollback()
+ */
+int recorder_attr_commit(recorder_h recorder, char **error_attribute);
+
+/**
+ * @brief  Discards all attributes staged since recorder_attr_begin().
+ * @param[in] recorder The handle to media recorder
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE No transaction is opened
+ * @pre A transaction must be opened by recorder_attr_begin()
+ * @see	recorder_attr_begin()
+ * @see	recorder_attr_commit()
+ */
+int recorder_attr_rollback(recorder_h recorder);
+
+/**
+ * @brief  Creates a recording profile.
+ * @remarks A profile is a named set of recording attributes which can be applied to a recorder by recorder_apply_profile().\n
+ * Only the attributes set to the profile are applied, others keep the values of the recorder.\n
+ * You must release @a profile using recorder_profile_destroy().
+ * @param[in] name The name of the profile
+ * @param[out] profile A newly returned handle to the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_profile_destroy()
+ */
+int recorder_profile_create(const char *name, recorder_profile_h *profile);
+
+/**
+ * @brief  Releases the profile handle.
+ * @remarks A registered profile is kept by the registry until it is unregistered.
+ * @param[in] profile The handle to the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_profile_create()
+ * @see	recorder_profile_lookup()
+ */
+int recorder_profile_destroy(recorder_profile_h profile);
+
+/**
+ * @brief  Gets the name of the profile.
+ * @remarks @a name must be released with @c free() by you.
+ * @param[in] profile The handle to the profile
+ * @param[out] name The name of the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_OUT_OF_MEMORY Out of memory
+ */
+int recorder_profile_get_name(recorder_profile_h profile, char **name);
+
+/**
+ * @brief  Sets the file format of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] format The file format
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_set_file_format()
+ */
+int recorder_profile_set_file_format(recorder_profile_h profile, recorder_file_format_e format);
+
+/**
+ * @brief  Sets the audio codec of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] codec The audio codec, #RECORDER_AUDIO_CODEC_DISABLE for video only recording
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_set_audio_encoder()
+ */
+int recorder_profile_set_audio_encoder(recorder_profile_h profile, recorder_audio_codec_e codec);
+
+/**
+ * @brief  Sets the video codec of the profile.
+ * @remarks A profile with video attributes can not be applied to an audio recorder.
+ * @param[in] profile The handle to the profile
+ * @param[in] codec The video codec
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_set_video_encoder()
+ */
+int recorder_profile_set_video_encoder(recorder_profile_h profile, recorder_video_codec_e codec);
+
+/**
+ * @brief  Sets the audio sampling rate of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] samplerate The sample rate in Hertz
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_attr_set_audio_samplerate()
+ */
+int recorder_profile_set_audio_samplerate(recorder_profile_h profile, int samplerate);
+
+/**
+ * @brief  Sets the number of audio channel of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] channel_count The number of audio channel
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_attr_set_audio_channel()
+ */
+int recorder_profile_set_audio_channel(recorder_profile_h profile, int channel_count);
+
+/**
+ * @brief  Sets the audio encoder bitrate of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] bitrate The audio encoder bitrate
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_attr_set_audio_encoder_bitrate()
+ */
+int recorder_profile_set_audio_encoder_bitrate(recorder_profile_h profile, int bitrate);
+
+/**
+ * @brief  Sets the video encoder bitrate of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] bitrate The video encoder bitrate
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_attr_set_video_encoder_bitrate()
+ */
+int recorder_profile_set_video_encoder_bitrate(recorder_profile_h profile, int bitrate);
+
+/**
+ * @brief  Sets the maximum size of a recording file of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] kbyte The maximum size of the recording file(KB), @c 0 means unlimited recording size.
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_attr_set_size_limit()
+ */
+int recorder_profile_set_size_limit(recorder_profile_h profile, int kbyte);
+
+/**
+ * @brief  Sets the time limit of a recording of the profile.
+ * @param[in] profile The handle to the profile
+ * @param[in] second The time limit of the recording (in seconds), @c 0 means unlimited recording time.
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE The profile is registered
+ * @see	recorder_attr_set_time_limit()
+ */
+int recorder_profile_set_time_limit(recorder_profile_h profile, int second);
+
+/**
+ * @brief  Registers the profile under its name for the process.
+ * @remarks A registered profile can not be changed any more, and replaces a profile already registered with the same name.\n
+ * The profile is checked against the capabilities only once per recorder type, and the result is reused by all recorders.\n
+ * You still have to release your handle using recorder_profile_destroy().
+ * @param[in] profile The handle to the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_profile_unregister()
+ * @see	recorder_profile_lookup()
+ */
+int recorder_profile_register(recorder_profile_h profile);
+
+/**
+ * @brief  Unregisters the profile registered with the name.
+ * @remarks Handles returned by recorder_profile_lookup() stay valid until they are released.
+ * @param[in] name The name of the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter or no profile is registered with the name
+ * @see	recorder_profile_register()
+ */
+int recorder_profile_unregister(const char *name);
+
+/**
+ * @brief  Looks up the profile registered with the name.
+ * @remarks You must release @a profile using recorder_profile_destroy().
+ * @param[in] name The name of the profile
+ * @param[out] profile The handle to the registered profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter or no profile is registered with the name
+ * @see	recorder_profile_register()
+ */
+int recorder_profile_lookup(const char *name, recorder_profile_h *profile);
+
+/**
+ * @brief  Serializes the profile into a binary data.
+ * @remarks @a data must be released with @c free() by you.
+ * @param[in] profile The handle to the profile
+ * @param[out] data The serialized profile
+ * @param[out] size The size of @a data in bytes
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_OUT_OF_MEMORY Out of memory
+ * @see	recorder_profile_deserialize()
+ */
+int recorder_profile_serialize(recorder_profile_h profile, void **data, int *size);
+
+/**
+ * @brief  Creates a profile from the data made by recorder_profile_serialize().
+ * @remarks You must release @a profile using recorder_profile_destroy().
+ * @param[in] data The serialized profile
+ * @param[in] size The size of @a data in bytes
+ * @param[out] profile A newly returned handle to the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter or malformed data
+ * @see	recorder_profile_serialize()
+ */
+int recorder_profile_deserialize(const void *data, int size, recorder_profile_h *profile);
+
+/**
+ * @brief  Applies all attributes of the profile to the recorder in one batch.
+ * @remarks The attributes are applied all together or not at all.
+ * @param[in] recorder The handle to media recorder
+ * @param[in] profile The handle to the profile
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter or the profile is not supported by the recorder
+ * @retval #RECORDER_ERROR_INVALID_STATE An attribute transaction is already opened, or an attribute can not be changed in the current state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @see	recorder_profile_create()
+ * @see	recorder_profile_lookup()
+ */
+int recorder_apply_profile(recorder_h recorder, recorder_profile_h profile);
+
+/**
+ * @brief  Exports the whole configuration of the recorder into a binary data.
+ * @remarks The data holds the attributes, the encoders, the file format and the filename of the recorder.\n
+ * It can be restored to a new recorder of the same type by recorder_import_config().\n
+ * @a data must be released with @c free() by you.
+ * @param[in] recorder The handle to media recorder
+ * @param[out] data The configuration data
+ * @param[out] size The size of @a data in bytes
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_OUT_OF_MEMORY Out of memory
+ * @see	recorder_import_config()
+ */
+int recorder_export_config(recorder_h recorder, void **data, int *size);
+
+/**
+ * @brief  Restores the configuration exported by recorder_export_config() in one batch.
+ * @remarks The configuration is applied all together or not at all.
+ * @param[in] recorder The handle to media recorder
+ * @param[in] data The configuration data
+ * @param[in] size The size of @a data in bytes
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter, malformed data or the configuration is not supported by the recorder
+ * @retval #RECORDER_ERROR_INVALID_STATE An attribute transaction is already opened, or an attribute can not be changed in the current state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @see	recorder_export_config()
+ */
+int recorder_import_config(recorder_h recorder, const void *data, int size);
+
+/**
+ * @}
+ */
+
+/**
+ * @addtogroup CAPI_MEDIA_RECORDER_MODULE
+ * @{
+ */
+
+/**
+ * @brief  Creates a pool which keeps audio recorders ready to be taken.
+ * @remarks The recorders are created in the background, so the pool may not be full right after this function returns.\n
+ * Every recorder taken by recorder_pool_acquire() is replaced in the background.\n
+ * The pool keeps its own reference to @a profile.
+ * @param[in] size The number of recorders kept in the pool
+ * @param[in] profile The profile applied to each recorder, or @c NULL to keep the default attributes
+ * @param[in] prepare If @c true, the recorders are prepared by recorder_prepare() before being pooled
+ * @param[out] pool A newly returned handle to the pool
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_pool_destroy()
+ * @see	recorder_pool_acquire()
+ */
+int recorder_pool_create(int size, recorder_profile_h profile, bool prepare, recorder_pool_h *pool);
+
+/**
+ * @brief  Destroys the pool and the recorders remaining in it.
+ * @remarks This function waits for the recorders being created in the background.\n
+ * Recorders taken from the pool are not affected.
+ * @param[in] pool The handle to the pool
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_pool_create()
+ */
+int recorder_pool_destroy(recorder_pool_h pool);
+
+/**
+ * @brief  Takes a recorder from the pool.
+ * @remarks The recorder is owned by you and must be released using recorder_destroy().\n
+ * If the pool is empty, a recorder is created in place with the pool settings.
+ * @param[in] pool The handle to the pool
+ * @param[out] recorder A handle to the audio recorder
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @post The recorder state is #RECORDER_STATE_READY if the pool prepares its recorders, otherwise #RECORDER_STATE_CREATED.
+ * @see	recorder_pool_create()
+ */
+int recorder_pool_acquire(recorder_pool_h pool, recorder_h *recorder);
+
+/**
+ * @brief  Gets the number of recorders ready in the pool.
+ * @param[in] pool The handle to the pool
+ * @param[out] count The number of recorders ready to be taken
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int recorder_pool_get_available_count(recorder_pool_h pool, int *count);
+
+/**
+ * @brief  Creates a group of audio recorders operated together.
+ * @remarks Group operations run on every recorder in parallel and return when all recorders are done.\n
+ * The group owns a bounded pool of threads, so in a large group some recorders wait for a free thread.\n
+ * The recording status callback of each recorder stays available to the application, the group collects its statistics separately.\n
+ * Each recorder needs its own recording file, set by recorder_set_filename() on the handle returned by recorder_group_get_recorder().\n
+ * The group keeps its own reference to @a profile.
+ * @param[in] count The number of recorders
+ * @param[in] profile The profile applied to each recorder, or @c NULL to keep the default attributes
+ * @param[out] group A newly returned handle to the group
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @post The recorder state of each recorder is #RECORDER_STATE_CREATED.
+ * @see	recorder_group_destroy()
+ */
+int recorder_group_create(int count, recorder_profile_h profile, recorder_group_h *group);
+
+/**
+ * @brief  Destroys the group and its recorders.
+ * @remarks Recording recorders are cancelled and prepared recorders are unprepared first.
+ * @param[in] group The handle to the group
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see	recorder_group_create()
+ */
+int recorder_group_destroy(recorder_group_h group);
+
+/**
+ * @brief  Gets the number of recorders in the group.
+ * @param[in] group The handle to the group
+ * @param[out] count The number of recorders
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int recorder_group_get_count(recorder_group_h group, int *count);
+
+/**
+ * @brief  Gets a recorder of the group.
+ * @remarks The recorder is owned by the group, do not destroy it.
+ * @param[in] group The handle to the group
+ * @param[in] index The index of the recorder, from 0 to the count of the group - 1
+ * @param[out] recorder The handle to the recorder
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int recorder_group_get_recorder(recorder_group_h group, int index, recorder_h *recorder);
+
+/**
+ * @brief  Applies a profile to every recorder of the group.
+ * @param[in] group The handle to the group
+ * @param[in] profile The profile to apply
+ * @return	0 on success, otherwise the error of the first failed recorder.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @see	recorder_apply_profile()
+ */
+int recorder_group_apply_profile(recorder_group_h group, recorder_profile_h profile);
+
+/**
+ * @brief  Prepares every recorder of the group, see recorder_prepare().
+ * @param[in] group The handle to the group
+ * @return	0 on success, otherwise the error of the first failed recorder.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ * @see	recorder_group_get_stats()
+ */
+int recorder_group_prepare(recorder_group_h group);
+
+/**
+ * @brief  Unprepares every recorder of the group, see recorder_unprepare().
+ * @param[in] group The handle to the group
+ * @return	0 on success, otherwise the error of the first failed recorder.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ */
+int recorder_group_unprepare(recorder_group_h group);
+
+/**
+ * @brief  Starts recording on every recorder of the group, see recorder_start().
+ * @param[in] group The handle to the group
+ * @return	0 on success, otherwise the error of the first failed recorder.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ */
+int recorder_group_start(recorder_group_h group);
+
+/**
+ * @brief  Stops recording and saves the result on every recorder of the group, see recorder_commit().
+ * @param[in] group The handle to the group
+ * @return	0 on success, otherwise the error of the first failed recorder.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ */
+int recorder_group_commit(recorder_group_h group);
+
+/**
+ * @brief  Stops recording and discards the result on every recorder of the group, see recorder_cancel().
+ * @param[in] group The handle to the group
+ * @return	0 on success, otherwise the error of the first failed recorder.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #RECORDER_ERROR_INVALID_STATE Invalid state
+ * @retval #RECORDER_ERROR_INVALID_OPERATION Invalid operation
+ */
+int recorder_group_cancel(recorder_group_h group);
+
+/**
+ * @brief  Gets the aggregated statistics of the group.
+ * @param[in] group The handle to the group
+ * @param[out] stats The statistics
+ * @return	0 on success, otherwise a negative error value.
+ * @retval #RECORDER_ERROR_NONE Successful
+ * @retval #RECORDER_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int recorder_group_get_stats(recorder_group_h group, recorder_group_stats_s *stats);
+
 /**
  * @}
  */
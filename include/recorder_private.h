@@ -18,6 +18,8 @@
 
 #ifndef __TIZEN_MULTIMEDIA_RECORDER_PRIVATE_H__
 #define	__TIZEN_MULTIMEDIA_RECORDER_PRIVATE_H__
+#include <sys/types.h>
+#include <glib.h>
 #include <camera.h>
 #include <mm_camcorder.h>
 #include <recorder.h>
@@ -33,14 +35,93 @@ typedef enum {
 	_RECORDER_EVENT_TYPE_INTERRUPTED,
 	_RECORDER_EVENT_TYPE_AUDIO_STREAM,
 	_RECORDER_EVENT_TYPE_ERROR,
+	_RECORDER_EVENT_TYPE_AUTO_RESUMED,
 	_RECORDER_EVENT_TYPE_NUM
 }_recorder_event_e;
 
 typedef enum {
 	_RECORDER_TYPE_AUDIO= 0,
-	_RECORDER_TYPE_VIDEO
+	_RECORDER_TYPE_VIDEO,
+	_RECORDER_TYPE_NUM
 }_recorder_type_e;
 
+typedef enum {
+	_RECORDER_CAPABILITY_FILE_FORMAT,
+	_RECORDER_CAPABILITY_AUDIO_ENCODER,
+	_RECORDER_CAPABILITY_VIDEO_ENCODER,
+	_RECORDER_CAPABILITY_NUM
+}_recorder_capability_e;
+
+#define _RECORDER_CAPABILITY_MAX_VALUES	16
+
+typedef struct {
+	int count;
+	int values[_RECORDER_CAPABILITY_MAX_VALUES];
+} _recorder_capability_values_s;
+
+typedef enum {
+	_RECORDER_ATTR_FILE_FORMAT = 0,
+	_RECORDER_ATTR_AUDIO_ENCODER,
+	_RECORDER_ATTR_AUDIO_DISABLE,
+	_RECORDER_ATTR_VIDEO_ENCODER,
+	_RECORDER_ATTR_AUDIO_SAMPLERATE,
+	_RECORDER_ATTR_AUDIO_ENCODER_BITRATE,
+	_RECORDER_ATTR_VIDEO_ENCODER_BITRATE,
+	_RECORDER_ATTR_AUDIO_CHANNEL,
+	_RECORDER_ATTR_AUDIO_DEVICE,
+	_RECORDER_ATTR_SIZE_LIMIT,
+	_RECORDER_ATTR_TIME_LIMIT,
+	_RECORDER_ATTR_ORIENTATION,
+	_RECORDER_ATTR_INT_NUM,		/* attributes above are int typed, below are double typed */
+	_RECORDER_ATTR_AUDIO_VOLUME = _RECORDER_ATTR_INT_NUM,
+	_RECORDER_ATTR_MOTION_RATE,
+	_RECORDER_ATTR_NUM
+}_recorder_attr_e;
+
+/* points of a take startup, timestamped from the entry of the API */
+typedef enum {
+	_RECORDER_LATENCY_START = 0,
+	_RECORDER_LATENCY_RETURN,
+	_RECORDER_LATENCY_STATE,
+	_RECORDER_LATENCY_BUFFER,
+	_RECORDER_LATENCY_STATUS,
+	_RECORDER_LATENCY_NUM
+}_recorder_latency_e;
+
+/* attributes the core reads when the pipeline is realized */
+#define _RECORDER_ATTR_REALIZE_MASK	((1 << _RECORDER_ATTR_FILE_FORMAT) | (1 << _RECORDER_ATTR_AUDIO_ENCODER) | (1 << _RECORDER_ATTR_AUDIO_DISABLE) | \
+		(1 << _RECORDER_ATTR_VIDEO_ENCODER) | (1 << _RECORDER_ATTR_AUDIO_SAMPLERATE) | (1 << _RECORDER_ATTR_AUDIO_CHANNEL) | (1 << _RECORDER_ATTR_AUDIO_DEVICE))
+
+/* attributes the core may adjust by itself when the pipeline is built or changes state */
+#define _RECORDER_ATTR_CORE_ADJUSTED_MASK	((1 << _RECORDER_ATTR_AUDIO_SAMPLERATE) | (1 << _RECORDER_ATTR_AUDIO_ENCODER_BITRATE) | \
+		(1 << _RECORDER_ATTR_VIDEO_ENCODER_BITRATE) | (1 << _RECORDER_ATTR_AUDIO_CHANNEL) | (1 << _RECORDER_ATTR_ORIENTATION))
+
+typedef union {
+	int value_int;
+	double value_double;
+}_recorder_attr_value_u;
+
+#define _RECORDER_ATTR_INFO_MAX_VALUES	16
+
+/* valid values of an attribute, copied from mm_camcorder_get_attribute_info() */
+typedef struct {
+	int validity_type;	/* MMCamAttrsValidType */
+	union {
+		struct {
+			int count;
+			int values[_RECORDER_ATTR_INFO_MAX_VALUES];
+		} int_array;
+		struct {
+			int min;
+			int max;
+		} int_range;
+		struct {
+			double min;
+			double max;
+		} double_range;
+	};
+}_recorder_attr_info_s;
+
 typedef struct _recorder_s{
 	MMHandleType mm_handle;
 	camera_h camera;
@@ -51,8 +132,161 @@ typedef struct _recorder_s{
 	int origin_preview_format;
 	double last_max_input_level;
 
+	bool attr_transaction;
+	unsigned int attr_staged;	/* bit mask of _recorder_attr_e */
+	_recorder_attr_value_u attr_staged_value[_RECORDER_ATTR_NUM];
+	char *staged_filename;
+
+	unsigned int attr_cache_valid;	/* bit mask of _recorder_attr_e */
+	_recorder_attr_value_u attr_cache[_RECORDER_ATTR_NUM];
+
+	unsigned int attr_info_loaded;	/* bit mask of _recorder_attr_e */
+	_recorder_attr_info_s attr_info[_RECORDER_ATTR_NUM];
+
+	GMutex async_lock;
+	GCond async_cond;
+	struct _recorder_async_job_s *async_job;	/* queued or running job, protected by async_lock */
+	volatile int commit_pending;	/* recorder_commit_async() is in progress, setters only stage */
+	bool speculative;	/* realized in the background after creation, not prepared yet */
+	bool speculative_stale;	/* an attribute read at realize time changed after the speculative realize */
+
+	int idle_timeout;	/* milliseconds in READY before the pipeline is released, 0 to keep it */
+	gint64 idle_deadline;	/* monotonic time of the release while armed */
+	bool idle_releasing;
+	bool idle_released;	/* unrealized by the idle policy, reported as READY */
+	bool idle_reacquiring;	/* prepared again by recorder_start(), still reported as READY */
+	recorder_idle_stats_s idle_stats;
+
+	GMutex latency_lock;
+	volatile int latency_pending;	/* bit mask of _recorder_latency_e not observed yet */
+	gint64 latency_mark[_RECORDER_LATENCY_NUM];
+	int latency_take_count;
+	int latency_worst;
+
+	int resume_timeout;	/* milliseconds to retry after a sound policy interruption, 0 to disable */
+	volatile int resume_abort;
+	gint64 interrupted_at;
+	int resume_segment;	/* number of segments started by the auto resume */
+	bool resume_report;	/* outcome of the auto resume below, reported by the job once the slot is free */
+	char *resume_filename;
+	int resume_gap;
+
+	struct _recorder_loop_s *loop;	/* loop recording, NULL if disabled */
+	struct _recorder_sink_s *sink;	/* output callbacks, NULL if the output is a file */
+	struct _recorder_writer_s *writer;	/* write-behind stage and durability, NULL if never set */
+
+	/* statistics of the group owning the recorder, invoked before the recording status callback of the application */
+	recorder_recording_status_cb group_status_cb;
+	void *group_status_data;
+
+	bool prealloc;
+	int prealloc_fd;	/* preallocated target of the running take, -1 if none */
+
+	/* capabilities of the camera device of a video recorder, audio capabilities are shared by the process */
+	_recorder_capability_values_s device_capability[_RECORDER_CAPABILITY_NUM];
+	unsigned int device_capability_loaded;	/* bit mask of _recorder_capability_e */
 } recorder_s;
 
+/*
+ * recorder_capability.c
+ */
+int _recorder_capability_get(recorder_s *handle, _recorder_capability_e capability, const int **values, int *count);
+
+/*
+ * recorder_profile.c
+ */
+recorder_profile_h _recorder_profile_ref(recorder_profile_h profile);
+
+/*
+ * recorder_worker.c
+ */
+typedef void (*_recorder_worker_func)(void *data);
+
+/* runs func(data) on a library thread, returns RECORDER_ERROR_NONE if the job is queued */
+int _recorder_worker_run(_recorder_worker_func func, void *data);
+
+/*
+ * recorder_async.c
+ */
+void _recorder_async_init(recorder_s *handle);
+/* cancels the queued job or waits for the running one, called before the handle is destroyed */
+void _recorder_async_flush(recorder_s *handle);
+/* waits for the queued or running job without cancelling it */
+void _recorder_async_wait(recorder_s *handle);
+/* queues the background realize of a new handle if enabled by recorder_set_speculative_realize() */
+void _recorder_async_realize(recorder_s *handle);
+/* waits for the background realize, other jobs are not waited for */
+void _recorder_async_wait_realize(recorder_s *handle);
+/* queues an internal job without completion callback */
+int _recorder_async_run(recorder_s *handle, int (*func)(recorder_h recorder));
+/* queues the auto resume after a sound policy interruption */
+int _recorder_async_resume(recorder_s *handle, int (*func)(recorder_h recorder));
+/* stops the auto resume in progress and waits for it, does nothing on the thread running the resume */
+void _recorder_async_abort_resume(recorder_s *handle);
+
+/*
+ * recorder_idle.c
+ */
+/* (re)starts the idle countdown of a handle entering READY */
+void _recorder_idle_arm(recorder_s *handle);
+/* stops the countdown, waits for a release in progress and returns whether the pipeline has been released */
+bool _recorder_idle_disarm(recorder_s *handle);
+/* like _recorder_idle_disarm(), a released handle stays reported as READY until _recorder_idle_reacquire_end() */
+bool _recorder_idle_reacquire_begin(recorder_s *handle);
+void _recorder_idle_reacquire_end(recorder_s *handle, bool prepared, int elapsed);
+/* the pipeline is released or being released or prepared again by the idle policy */
+bool _recorder_idle_is_released(recorder_s *handle);
+
+/*
+ * recorder_loop.c
+ */
+/* file of the first segment when a loop recording starts, NULL if loop recording is disabled */
+char *_recorder_loop_first_segment(recorder_s *handle);
+/* rotates the segments on a time limit, returns false if loop recording is disabled or the rotation can not be queued */
+bool _recorder_loop_limit_reached(recorder_s *handle);
+void _recorder_loop_destroy(recorder_s *handle);
+
+/*
+ * recorder_sink.c
+ */
+/* starts delivering a take to the output callbacks, path is the target to give to the core, NULL without callbacks */
+int _recorder_sink_begin(recorder_s *handle, char **path);
+/* waits until the take is delivered, called once the core has closed the target */
+void _recorder_sink_end(recorder_s *handle);
+void _recorder_sink_destroy(recorder_s *handle);
+
+/*
+ * recorder_prealloc.c
+ */
+/* reserves the estimated size of the take once the core has opened the target */
+int _recorder_prealloc_begin(recorder_s *handle);
+/* releases the unused reservation once the take is finalized */
+void _recorder_prealloc_end(recorder_s *handle);
+
+/*
+ * recorder_writer.c
+ */
+/* opens filename, or the file of the application if NULL, and starts the write-behind stage,
+ * path is the target to give to the core, NULL if the take is written directly */
+int _recorder_writer_begin(recorder_s *handle, const char *filename, char **path);
+/* target of the running take, NULL if it is written directly */
+char *_recorder_writer_get_path(recorder_s *handle);
+/* drains the stage once the core has closed the target and restores the filename, commit applies the durability policy.
+ * Returns RECORDER_ERROR_INVALID_OPERATION if the take could not be written completely */
+int _recorder_writer_end(recorder_s *handle, bool commit);
+void _recorder_writer_destroy(recorder_s *handle);
+
+/*
+ * recorder_uring.c
+ */
+/* false if built without io_uring or if the shared ring can not be set up */
+bool _recorder_uring_available(void);
+/* registers a write-behind buffer in the fixed buffer table, index is -1 if it is not registered */
+void _recorder_uring_register(void *data, int size, int *index);
+void _recorder_uring_unregister(int index);
+/* pwrite() through the shared ring, index is the fixed buffer holding data or -1 */
+ssize_t _recorder_uring_pwrite(int fd, const void *data, int size, off_t offset, int index);
+
 #ifdef __cplusplus
 }
 #endif
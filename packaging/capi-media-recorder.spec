@@ -1,3 +1,4 @@
+%bcond_with io_uring
 Name:       capi-media-recorder
 Summary:    A Recorder library in Tizen C API
 Version:    0.1.0
@@ -11,6 +12,11 @@ BuildRequires:  pkgconfig(mm-camcorder)
 BuildRequires:  pkgconfig(capi-base-common)
 BuildRequires:  pkgconfig(capi-media-camera)
 BuildRequires:  pkgconfig(capi-media-audio-io)
+BuildRequires:  pkgconfig(glib-2.0)
+BuildRequires:  pkgconfig(gthread-2.0)
+%if %{with io_uring}
+BuildRequires:  pkgconfig(liburing)
+%endif
 Requires(post): /sbin/ldconfig  
 Requires(postun): /sbin/ldconfig
 
@@ -29,7 +35,7 @@ Requires: %{name} = %{version}-%{release}
 
 %build
 MAJORVER=`echo %{version} | awk 'BEGIN {FS="."}{print $1}'`
-cmake . -DCMAKE_INSTALL_PREFIX=/usr -DFULLVER=%{version} -DMAJORVER=${MAJORVER}
+cmake . -DCMAKE_INSTALL_PREFIX=/usr -DFULLVER=%{version} -DMAJORVER=${MAJORVER} %{?with_io_uring:-DUSE_IO_URING=ON}
 
 
 make %{?jobs:-j%jobs}
@@ -47,6 +47,7 @@ int _camera_set_relay_mm_message_callback(camera_h camera, MMMessageCallback cal
 
 static int __mm_audio_stream_cb(MMCamcorderAudioStreamDataType *stream, void *user_param);
 static int __mm_recorder_msg_cb(int message, void *param, void *user_data);
+static int __recorder_auto_resume(recorder_h recorder);
 
 
 static int __convert_error_code_camera_to_recorder(int code){
@@ -69,132 +70,684 @@ static int __convert_error_code_camera_to_recorder(int code){
 	return new_code;
 }
 
-static int __convert_recorder_error_code(const char *func, int code){
-	int ret = RECORDER_ERROR_INVALID_OPERATION;
-	char *errorstr = NULL;
-	
-	switch(code)
-	{
-		case RECORDER_ERROR_INVALID_PARAMETER:
-			ret = RECORDER_ERROR_INVALID_PARAMETER;
-			errorstr = "INVALID_PARAMETER";			
-			break;			
-		case MM_ERROR_NONE:
-			ret = RECORDER_ERROR_NONE;
-			errorstr = "ERROR_NONE";
-			break;
-		case MM_ERROR_CAMCORDER_INVALID_ARGUMENT :
-		case MM_ERROR_COMMON_INVALID_ATTRTYPE :
-		case MM_ERROR_COMMON_INVALID_PERMISSION :
-		case MM_ERROR_COMMON_OUT_OF_ARRAY :
-		case MM_ERROR_COMMON_OUT_OF_RANGE :
-		case MM_ERROR_COMMON_ATTR_NOT_EXIST :
-			ret = RECORDER_ERROR_INVALID_PARAMETER;
-			errorstr = "INVALID_PARAMETER";			
-			break;
-		case MM_ERROR_CAMCORDER_NOT_INITIALIZED :
-		case MM_ERROR_CAMCORDER_INVALID_STATE :
-			ret = RECORDER_ERROR_INVALID_STATE;
-			errorstr = "INVALID_STATE";			
-			break;
+/*
+ * CAPI <-> mm_camcorder enum mapping tables
+ * Each map is listed once as (CAPI value, mm value) pairs and expanded into a forward and a reverse table.
+ * Reverse tables store CAPI value + 1, so 0 marks a mm value without CAPI counterpart.
+ */
+#define __RECORDER_FILE_FORMAT_MAP(X) \
+	X(RECORDER_FILE_FORMAT_3GP,	MM_FILE_FORMAT_3GP) \
+	X(RECORDER_FILE_FORMAT_MP4,	MM_FILE_FORMAT_MP4) \
+	X(RECORDER_FILE_FORMAT_AMR,	MM_FILE_FORMAT_AMR) \
+	X(RECORDER_FILE_FORMAT_ADTS,	MM_FILE_FORMAT_AAC) \
+	X(RECORDER_FILE_FORMAT_WAV,	MM_FILE_FORMAT_WAV)
+
+#define __RECORDER_AUDIO_CODEC_MAP(X) \
+	X(RECORDER_AUDIO_CODEC_AMR,	MM_AUDIO_CODEC_AMR) \
+	X(RECORDER_AUDIO_CODEC_AAC,	MM_AUDIO_CODEC_AAC) \
+	X(RECORDER_AUDIO_CODEC_VORBIS,	MM_AUDIO_CODEC_VORBIS) \
+	X(RECORDER_AUDIO_CODEC_PCM,	MM_AUDIO_CODEC_WAVE)
+
+#define __RECORDER_VIDEO_CODEC_MAP(X) \
+	X(RECORDER_VIDEO_CODEC_H263,	MM_VIDEO_CODEC_H263) \
+	X(RECORDER_VIDEO_CODEC_H264,	MM_VIDEO_CODEC_H264) \
+	X(RECORDER_VIDEO_CODEC_MPEG4,	MM_VIDEO_CODEC_MPEG4) \
+	X(RECORDER_VIDEO_CODEC_THEORA,	MM_VIDEO_CODEC_THEORA)
+
+#define __RECORDER_MAP_FORWARD(capi, mm)	[capi] = (mm),
+#define __RECORDER_MAP_REVERSE(capi, mm)	[mm] = (capi) + 1,
+#define __RECORDER_MAP_CAPI_BIT(capi, mm)	| (1ULL << (capi))
+#define __RECORDER_MAP_MM_BIT(capi, mm)	| (1ULL << (mm))
+#define __RECORDER_MAP_MM_SUM(capi, mm)	+ (1ULL << (mm))
 
-		case MM_ERROR_CAMCORDER_DEVICE :
-		case MM_ERROR_CAMCORDER_DEVICE_NOT_FOUND :
-		case MM_ERROR_CAMCORDER_DEVICE_BUSY	:
-		case MM_ERROR_CAMCORDER_DEVICE_OPEN :
-		case MM_ERROR_CAMCORDER_DEVICE_IO :
-		case MM_ERROR_CAMCORDER_DEVICE_TIMEOUT	:
-		case MM_ERROR_CAMCORDER_DEVICE_REG_TROUBLE :
-		case MM_ERROR_CAMCORDER_DEVICE_WRONG_JPEG	 :
-		case MM_ERROR_CAMCORDER_DEVICE_LACK_BUFFER :
-			ret = RECORDER_ERROR_DEVICE;
-			errorstr = "ERROR_DEVICE";			
-			break;
+/*
+ * Defines __recorder_<name>_to_mm() and __recorder_<name>_from_mm(), both return -1 for an unmapped value.
+ * Build fails if a CAPI value in [0, capi_num) is not mapped or a mm value is mapped twice.
+ */
+#define __RECORDER_ENUM_MAP_DEFINE(name, MAP, capi_num, mm_num) \
+	static const int __recorder_##name##_to_mm_table[capi_num] = { MAP(__RECORDER_MAP_FORWARD) }; \
+	static const signed char __recorder_##name##_from_mm_table[mm_num] = { MAP(__RECORDER_MAP_REVERSE) }; \
+	typedef char __recorder_##name##_gap_check[((0 MAP(__RECORDER_MAP_CAPI_BIT)) == ((1ULL << (capi_num)) - 1)) ? 1 : -1]; \
+	typedef char __recorder_##name##_duplicate_check[((0 MAP(__RECORDER_MAP_MM_SUM)) == (0 MAP(__RECORDER_MAP_MM_BIT))) ? 1 : -1]; \
+	static inline int __recorder_##name##_to_mm(int value){ \
+		if( value < 0 || value >= (capi_num) ) \
+			return -1; \
+		return __recorder_##name##_to_mm_table[value]; \
+	} \
+	static inline int __recorder_##name##_from_mm(int value){ \
+		if( value < 0 || value >= (mm_num) ) \
+			return -1; \
+		return __recorder_##name##_from_mm_table[value] - 1; \
+	}
 
-		case MM_ERROR_CAMCORDER_GST_CORE :
-		case MM_ERROR_CAMCORDER_GST_LIBRARY :
-		case MM_ERROR_CAMCORDER_GST_RESOURCE :
-		case MM_ERROR_CAMCORDER_GST_STREAM :
-		case MM_ERROR_CAMCORDER_GST_STATECHANGE :
-		case MM_ERROR_CAMCORDER_GST_NEGOTIATION :
-		case MM_ERROR_CAMCORDER_GST_LINK :
-		case MM_ERROR_CAMCORDER_GST_FLOW_ERROR :
-		case MM_ERROR_CAMCORDER_ENCODER :
-		case MM_ERROR_CAMCORDER_ENCODER_BUFFER :
-		case MM_ERROR_CAMCORDER_ENCODER_WRONG_TYPE :
-		case MM_ERROR_CAMCORDER_ENCODER_WORKING :
-		case MM_ERROR_CAMCORDER_INTERNAL :
-		case MM_ERROR_CAMCORDER_NOT_SUPPORTED :
-		case MM_ERROR_CAMCORDER_RESPONSE_TIMEOUT :
-		case MM_ERROR_CAMCORDER_CMD_IS_RUNNING :	
-		case MM_ERROR_CAMCORDER_DSP_FAIL :
-		case MM_ERROR_CAMCORDER_AUDIO_EMPTY :
-		case MM_ERROR_CAMCORDER_CREATE_CONFIGURE :
-		case MM_ERROR_CAMCORDER_FILE_SIZE_OVER :
-		case MM_ERROR_CAMCORDER_DISPLAY_DEVICE_OFF :
-		case MM_ERROR_CAMCORDER_INVALID_CONDITION :
-			ret = RECORDER_ERROR_INVALID_OPERATION;
-			errorstr = "INVALID_OPERATION";			
-			break;
-		case MM_ERROR_CAMCORDER_RESOURCE_CREATION :
-		case MM_ERROR_COMMON_OUT_OF_MEMORY:	
-			ret = RECORDER_ERROR_OUT_OF_MEMORY;
-			errorstr = "OUT_OF_MEMORY";			
-			break;
+__RECORDER_ENUM_MAP_DEFINE(file_format, __RECORDER_FILE_FORMAT_MAP, RECORDER_FILE_FORMAT_WAV + 1, MM_FILE_FORMAT_NUM)
+__RECORDER_ENUM_MAP_DEFINE(audio_codec, __RECORDER_AUDIO_CODEC_MAP, RECORDER_AUDIO_CODEC_PCM + 1, MM_AUDIO_CODEC_NUM)
+__RECORDER_ENUM_MAP_DEFINE(video_codec, __RECORDER_VIDEO_CODEC_MAP, RECORDER_VIDEO_CODEC_THEORA + 1, MM_VIDEO_CODEC_NUM)
 
-		case MM_ERROR_POLICY_BLOCKED:
-			ret = RECORDER_ERROR_SOUND_POLICY;
-			errorstr = "ERROR_SOUND_POLICY";			
-			break;
+#define __RECORDER_STATE_MAP(X) \
+	X(MM_CAMCORDER_STATE_NONE,	RECORDER_STATE_NONE) \
+	X(MM_CAMCORDER_STATE_NULL,	RECORDER_STATE_CREATED) \
+	X(MM_CAMCORDER_STATE_READY,	RECORDER_STATE_CREATED) \
+	X(MM_CAMCORDER_STATE_PREPARE,	RECORDER_STATE_READY) \
+	X(MM_CAMCORDER_STATE_CAPTURING,	RECORDER_STATE_READY) \
+	X(MM_CAMCORDER_STATE_RECORDING,	RECORDER_STATE_RECORDING) \
+	X(MM_CAMCORDER_STATE_PAUSED,	RECORDER_STATE_PAUSED)
 
-		case MM_ERROR_POLICY_RESTRICTED:
-			ret = RECORDER_ERROR_SECURITY_RESTRICTED;
-			errorstr = "ERROR_RESTRICTED";
-			break;
+#define __RECORDER_STATE_ENTRY(mm, capi)	[mm] = (capi),
+#define __RECORDER_STATE_BIT(mm, capi)	| (1ULL << (mm))
 
-		default:
-			ret = RECORDER_ERROR_INVALID_OPERATION;
-			errorstr = "INVALID_OPERATION";
-		
+static const recorder_state_e __recorder_state_table[MM_CAMCORDER_STATE_NUM] = { __RECORDER_STATE_MAP(__RECORDER_STATE_ENTRY) };
+typedef char __recorder_state_gap_check[((0 __RECORDER_STATE_MAP(__RECORDER_STATE_BIT)) == ((1ULL << MM_CAMCORDER_STATE_NUM) - 1)) ? 1 : -1];
+
+/*
+ * core error code -> CAPI error code, and the name logged for it
+ * Codes not listed are reported as RECORDER_ERROR_INVALID_OPERATION.
+ */
+#define __RECORDER_ERROR_MAP(X) \
+	X(MM_ERROR_NONE,				NONE,	"ERROR_NONE") \
+	X(RECORDER_ERROR_INVALID_PARAMETER,		INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_CAMCORDER_INVALID_ARGUMENT,		INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_COMMON_INVALID_ATTRTYPE,		INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_COMMON_INVALID_PERMISSION,		INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_COMMON_OUT_OF_ARRAY,			INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_COMMON_OUT_OF_RANGE,			INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_COMMON_ATTR_NOT_EXIST,		INVALID_PARAMETER,	"INVALID_PARAMETER") \
+	X(MM_ERROR_CAMCORDER_NOT_INITIALIZED,		INVALID_STATE,	"INVALID_STATE") \
+	X(MM_ERROR_CAMCORDER_INVALID_STATE,		INVALID_STATE,	"INVALID_STATE") \
+	X(MM_ERROR_CAMCORDER_DEVICE,			DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_NOT_FOUND,		DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_BUSY,		DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_OPEN,		DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_IO,			DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_TIMEOUT,		DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_REG_TROUBLE,	DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_WRONG_JPEG,		DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_DEVICE_LACK_BUFFER,	DEVICE,	"ERROR_DEVICE") \
+	X(MM_ERROR_CAMCORDER_RESOURCE_CREATION,		OUT_OF_MEMORY,	"OUT_OF_MEMORY") \
+	X(MM_ERROR_COMMON_OUT_OF_MEMORY,		OUT_OF_MEMORY,	"OUT_OF_MEMORY") \
+	X(MM_ERROR_POLICY_BLOCKED,			SOUND_POLICY,	"ERROR_SOUND_POLICY") \
+	X(MM_ERROR_POLICY_RESTRICTED,			SECURITY_RESTRICTED,	"ERROR_RESTRICTED")
+
+#define __RECORDER_ERROR_ENTRY(mm, capi, name)	{ (mm), RECORDER_ERROR_##capi, name },
+
+typedef struct {
+	int code;
+	int recorder_code;
+	const char *name;
+} __recorder_error_map_s;
+
+static const __recorder_error_map_s __recorder_error_map[] = { __RECORDER_ERROR_MAP(__RECORDER_ERROR_ENTRY) };
+
+#define __RECORDER_ERROR_MAP_NUM	(sizeof(__recorder_error_map) / sizeof(__recorder_error_map[0]))
+#define __RECORDER_ERROR_HASH_BITS	7
+#define __RECORDER_ERROR_HASH_SIZE	(1 << __RECORDER_ERROR_HASH_BITS)
+
+/* keeps the open addressing table at most half full */
+typedef char __recorder_error_hash_check[(__RECORDER_ERROR_MAP_NUM * 2 <= __RECORDER_ERROR_HASH_SIZE) ? 1 : -1];
+
+/* index + 1 of __recorder_error_map, 0 is an empty slot */
+static unsigned char __recorder_error_hash[__RECORDER_ERROR_HASH_SIZE];
+
+static inline unsigned int __recorder_error_hash_slot(int code){
+	return ((unsigned int)code * 2654435761U) >> (32 - __RECORDER_ERROR_HASH_BITS);
+}
+
+static const __recorder_error_map_s *__recorder_error_lookup(int code){
+	static gsize initialized = 0;
+	unsigned int slot;
+	unsigned int i;
+
+	if( g_once_init_enter(&initialized) ){
+		for( i = 0 ; i < __RECORDER_ERROR_MAP_NUM ; i++ ){
+			slot = __recorder_error_hash_slot(__recorder_error_map[i].code);
+			while( __recorder_error_hash[slot] != 0 )
+				slot = (slot + 1) & (__RECORDER_ERROR_HASH_SIZE - 1);
+			__recorder_error_hash[slot] = i + 1;
+		}
+		g_once_init_leave(&initialized, 1);
 	}
 
+	slot = __recorder_error_hash_slot(code);
+	while( __recorder_error_hash[slot] != 0 ){
+		const __recorder_error_map_s *entry = &__recorder_error_map[__recorder_error_hash[slot] - 1];
+		if( entry->code == code )
+			return entry;
+		slot = (slot + 1) & (__RECORDER_ERROR_HASH_SIZE - 1);
+	}
+	return NULL;
+}
+
+static int __convert_recorder_error_code(const char *func, int code){
+	const __recorder_error_map_s *entry = __recorder_error_lookup(code);
+	int ret = entry ? entry->recorder_code : RECORDER_ERROR_INVALID_OPERATION;
+	const char *errorstr = entry ? entry->name : "INVALID_OPERATION";
+
 	LOGE( "[%s] %s(0x%08x) : core frameworks error code(0x%08x)",func, errorstr, ret, code);
-	
 
 	return ret;
 }
 
 static recorder_state_e __recorder_state_convert(MMCamcorderStateType mm_state )
 {
-	recorder_state_e state = RECORDER_STATE_NONE;
-	switch( mm_state ){
-		case MM_CAMCORDER_STATE_NONE:	
-			state = RECORDER_STATE_NONE;
-			break;
-		case MM_CAMCORDER_STATE_NULL:
-			state = RECORDER_STATE_CREATED;
-			break;
-		case MM_CAMCORDER_STATE_READY:
-			state = RECORDER_STATE_CREATED;
-			break;
-		case MM_CAMCORDER_STATE_PREPARE:
-			state = RECORDER_STATE_READY;
-			break;
-		case MM_CAMCORDER_STATE_CAPTURING:
-			state = RECORDER_STATE_READY;
-			break;
-		case MM_CAMCORDER_STATE_RECORDING:
-			state = RECORDER_STATE_RECORDING;
-			break;
-		case MM_CAMCORDER_STATE_PAUSED:
-			state = RECORDER_STATE_PAUSED;
-			break;
+	if( mm_state < MM_CAMCORDER_STATE_NONE || mm_state >= MM_CAMCORDER_STATE_NUM )
+		return RECORDER_STATE_NONE;
+	return __recorder_state_table[mm_state];
+}
+
+/*
+ * Attribute staging
+ *
+ * Every attribute setter stages its value in the handle and flushes the staged set with a single
+ * mm_camcorder_set_attributes() call. Between recorder_attr_begin() and recorder_attr_commit()
+ * the flush is deferred, so a whole configuration costs one trip through the core's attribute lock.
+ */
+static const char *__recorder_attr_name[_RECORDER_ATTR_NUM] = {
+	MMCAM_FILE_FORMAT,		//_RECORDER_ATTR_FILE_FORMAT
+	MMCAM_AUDIO_ENCODER,		//_RECORDER_ATTR_AUDIO_ENCODER
+	MMCAM_AUDIO_DISABLE,		//_RECORDER_ATTR_AUDIO_DISABLE
+	MMCAM_VIDEO_ENCODER,		//_RECORDER_ATTR_VIDEO_ENCODER
+	MMCAM_AUDIO_SAMPLERATE,		//_RECORDER_ATTR_AUDIO_SAMPLERATE
+	MMCAM_AUDIO_ENCODER_BITRATE,	//_RECORDER_ATTR_AUDIO_ENCODER_BITRATE
+	MMCAM_VIDEO_ENCODER_BITRATE,	//_RECORDER_ATTR_VIDEO_ENCODER_BITRATE
+	MMCAM_AUDIO_CHANNEL,		//_RECORDER_ATTR_AUDIO_CHANNEL
+	MMCAM_AUDIO_DEVICE,		//_RECORDER_ATTR_AUDIO_DEVICE
+	"target-max-size",		//_RECORDER_ATTR_SIZE_LIMIT
+	MMCAM_TARGET_TIME_LIMIT,	//_RECORDER_ATTR_TIME_LIMIT
+	"camcorder-rotation",		//_RECORDER_ATTR_ORIENTATION
+	MMCAM_AUDIO_VOLUME,		//_RECORDER_ATTR_AUDIO_VOLUME
+	"camera-recording-motion-rate"	//_RECORDER_ATTR_MOTION_RATE
+};
+
+/* mm_camcorder_set_attributes() stops at the first NULL name, so unused slots are simply left NULL */
+#define __RECORDER_ATTR_INT_ARGS(n, v) \
+	n[0], v[0], n[1], v[1], n[2], v[2], n[3], v[3], n[4], v[4], n[5], v[5], \
+	n[6], v[6], n[7], v[7], n[8], v[8], n[9], v[9], n[10], v[10], n[11], v[11]
+#define __RECORDER_ATTR_DOUBLE_ARGS(n, v) \
+	n[0], v[0], n[1], v[1]
+
+typedef char __recorder_attr_int_args_check[(_RECORDER_ATTR_INT_NUM == 12) ? 1 : -1];
+typedef char __recorder_attr_double_args_check[(_RECORDER_ATTR_NUM - _RECORDER_ATTR_INT_NUM == 2) ? 1 : -1];
+
+/*
+ * Staged values are guarded by async_lock : a worker running recorder_commit_async() flushes them
+ * and the writer drops its pipe path while the application keeps calling setters.
+ * The lock is never held across a core call.
+ */
+static void __recorder_attr_stage_int(recorder_s *handle, _recorder_attr_e attr, int value){
+	g_mutex_lock(&handle->async_lock);
+	handle->attr_staged_value[attr].value_int = value;
+	handle->attr_staged |= (1 << attr);
+	g_mutex_unlock(&handle->async_lock);
+}
+
+static void __recorder_attr_stage_double(recorder_s *handle, _recorder_attr_e attr, double value){
+	g_mutex_lock(&handle->async_lock);
+	handle->attr_staged_value[attr].value_double = value;
+	handle->attr_staged |= (1 << attr);
+	g_mutex_unlock(&handle->async_lock);
+}
+
+static void __recorder_attr_clear_staged(recorder_s *handle){
+	char *filename;
+
+	g_mutex_lock(&handle->async_lock);
+	handle->attr_staged = 0;
+	filename = handle->staged_filename;
+	handle->staged_filename = NULL;
+	g_mutex_unlock(&handle->async_lock);
+
+	if( filename )
+		free(filename);
+}
+
+static bool __recorder_attr_has_staged(recorder_s *handle){
+	bool staged;
+
+	g_mutex_lock(&handle->async_lock);
+	staged = (handle->attr_staged || handle->staged_filename);
+	g_mutex_unlock(&handle->async_lock);
+	return staged;
+}
+
+/*
+ * Attribute cache
+ *
+ * Values known to be applied in the core are kept in the handle, so getters don't go through the core.
+ * The cache is filled on create, updated by every successful flush and must be invalidated
+ * whenever the core may change attributes by itself : values the core adjusts are dropped after a prepare,
+ * on every core state change and after a rejected flush.
+ */
+static void __recorder_attr_cache_invalidate(recorder_s *handle){
+	handle->attr_cache_valid = 0;
+	handle->attr_info_loaded = 0;
+}
+
+static void __recorder_attr_cache_drop(recorder_s *handle, unsigned int mask){
+	handle->attr_cache_valid &= ~mask;
+}
+
+static void __recorder_attr_cache_fill(recorder_s *handle){
+	const char *int_name[_RECORDER_ATTR_INT_NUM];
+	int *int_value[_RECORDER_ATTR_INT_NUM];
+	const char *double_name[_RECORDER_ATTR_NUM - _RECORDER_ATTR_INT_NUM];
+	double *double_value[_RECORDER_ATTR_NUM - _RECORDER_ATTR_INT_NUM];
+	int ret;
+	int i;
+
+	__recorder_attr_cache_invalidate(handle);
+
+	for( i = 0 ; i < _RECORDER_ATTR_NUM ; i++ ){
+		if( i < _RECORDER_ATTR_INT_NUM ){
+			int_name[i] = __recorder_attr_name[i];
+			int_value[i] = &handle->attr_cache[i].value_int;
+		}else{
+			double_name[i - _RECORDER_ATTR_INT_NUM] = __recorder_attr_name[i];
+			double_value[i - _RECORDER_ATTR_INT_NUM] = &handle->attr_cache[i].value_double;
+		}
+	}
+
+	ret = mm_camcorder_get_attributes(handle->mm_handle, NULL, __RECORDER_ATTR_INT_ARGS(int_name, int_value), (void*)NULL);
+	if( ret == MM_ERROR_NONE )
+		handle->attr_cache_valid |= (1 << _RECORDER_ATTR_INT_NUM) - 1;
+	ret = mm_camcorder_get_attributes(handle->mm_handle, NULL, __RECORDER_ATTR_DOUBLE_ARGS(double_name, double_value), (void*)NULL);
+	if( ret == MM_ERROR_NONE )
+		handle->attr_cache_valid |= ((1 << _RECORDER_ATTR_NUM) - 1) & ~((1 << _RECORDER_ATTR_INT_NUM) - 1);
+}
+
+/*
+ * Attribute validation
+ *
+ * Valid ranges and enumerations are loaded from the core on first use and kept with the cache,
+ * so out of range values are rejected in the handle without a trip through the core.
+ */
+static const _recorder_attr_info_s *__recorder_attr_info(recorder_s *handle, _recorder_attr_e attr){
+	_recorder_attr_info_s *info = &handle->attr_info[attr];
+	MMCamAttrsInfo mm_info;
+
+	if( handle->attr_info_loaded & (1 << attr) )
+		return info;
+
+	memset(&mm_info, 0, sizeof(mm_info));
+	info->validity_type = MM_CAM_ATTRS_VALID_TYPE_NONE;
+	if( mm_camcorder_get_attribute_info(handle->mm_handle, __recorder_attr_name[attr], &mm_info) == MM_ERROR_NONE ){
+		switch( mm_info.validity_type ){
+			case MM_CAM_ATTRS_VALID_TYPE_INT_ARRAY:
+				/* too many values to keep, leave it to the core */
+				if( mm_info.int_array.array == NULL || mm_info.int_array.count > _RECORDER_ATTR_INFO_MAX_VALUES )
+					break;
+				info->int_array.count = mm_info.int_array.count;
+				memcpy(info->int_array.values, mm_info.int_array.array, sizeof(int) * mm_info.int_array.count);
+				info->validity_type = MM_CAM_ATTRS_VALID_TYPE_INT_ARRAY;
+				break;
+			case MM_CAM_ATTRS_VALID_TYPE_INT_RANGE:
+				info->int_range.min = mm_info.int_range.min;
+				info->int_range.max = mm_info.int_range.max;
+				info->validity_type = MM_CAM_ATTRS_VALID_TYPE_INT_RANGE;
+				break;
+			case MM_CAM_ATTRS_VALID_TYPE_DOUBLE_RANGE:
+				info->double_range.min = mm_info.double_range.min;
+				info->double_range.max = mm_info.double_range.max;
+				info->validity_type = MM_CAM_ATTRS_VALID_TYPE_DOUBLE_RANGE;
+				break;
+			default:
+				break;
+		}
+	}
+	handle->attr_info_loaded |= (1 << attr);
+
+	return info;
+}
+
+static bool __recorder_attr_check_int(recorder_s *handle, _recorder_attr_e attr, int value, const char *func){
+	const _recorder_attr_info_s *info = __recorder_attr_info(handle, attr);
+	int i;
+
+	switch( info->validity_type ){
+		case MM_CAM_ATTRS_VALID_TYPE_INT_ARRAY:
+			for( i = 0 ; i < info->int_array.count ; i++ ){
+				if( info->int_array.values[i] == value )
+					return true;
+			}
+			LOGE("[%s] INVALID_PARAMETER(0x%08x) : %d is not supported for [%s]", func, RECORDER_ERROR_INVALID_PARAMETER, value, __recorder_attr_name[attr]);
+			return false;
+		case MM_CAM_ATTRS_VALID_TYPE_INT_RANGE:
+			if( value >= info->int_range.min && value <= info->int_range.max )
+				return true;
+			LOGE("[%s] INVALID_PARAMETER(0x%08x) : %d is out of [%s] range [%d, %d]", func, RECORDER_ERROR_INVALID_PARAMETER, value, __recorder_attr_name[attr], info->int_range.min, info->int_range.max);
+			return false;
 		default:
-			state = RECORDER_STATE_NONE;
-			break;
+			return true;
 	}
+}
 
-	return state;
+static bool __recorder_attr_check_double(recorder_s *handle, _recorder_attr_e attr, double value, const char *func){
+	const _recorder_attr_info_s *info = __recorder_attr_info(handle, attr);
+
+	if( info->validity_type != MM_CAM_ATTRS_VALID_TYPE_DOUBLE_RANGE )
+		return true;
+	if( value >= info->double_range.min && value <= info->double_range.max )
+		return true;
+	LOGE("[%s] INVALID_PARAMETER(0x%08x) : %f is out of [%s] range [%f, %f]", func, RECORDER_ERROR_INVALID_PARAMETER, value, __recorder_attr_name[attr], info->double_range.min, info->double_range.max);
+	return false;
+}
+
+/* read-through : only an invalidated attribute goes to the core */
+static int __recorder_attr_get_int(recorder_s *handle, _recorder_attr_e attr, int *value){
+	if( !(handle->attr_cache_valid & (1 << attr)) ){
+		int ret = mm_camcorder_get_attributes(handle->mm_handle, NULL, __recorder_attr_name[attr], &handle->attr_cache[attr].value_int, NULL);
+		if( ret != MM_ERROR_NONE )
+			return ret;
+		handle->attr_cache_valid |= (1 << attr);
+	}
+	*value = handle->attr_cache[attr].value_int;
+	return MM_ERROR_NONE;
+}
+
+static int __recorder_attr_get_double(recorder_s *handle, _recorder_attr_e attr, double *value){
+	if( !(handle->attr_cache_valid & (1 << attr)) ){
+		int ret = mm_camcorder_get_attributes(handle->mm_handle, NULL, __recorder_attr_name[attr], &handle->attr_cache[attr].value_double, NULL);
+		if( ret != MM_ERROR_NONE )
+			return ret;
+		handle->attr_cache_valid |= (1 << attr);
+	}
+	*value = handle->attr_cache[attr].value_double;
+	return MM_ERROR_NONE;
+}
+
+static int __recorder_attr_flush(recorder_s *handle, char **error_attr){
+	const char *int_name[_RECORDER_ATTR_INT_NUM];
+	int int_value[_RECORDER_ATTR_INT_NUM];
+	const char *double_name[_RECORDER_ATTR_NUM - _RECORDER_ATTR_INT_NUM];
+	double double_value[_RECORDER_ATTR_NUM - _RECORDER_ATTR_INT_NUM];
+	int int_count = 0;
+	int double_count = 0;
+	_recorder_attr_value_u staged_value[_RECORDER_ATTR_NUM];
+	unsigned int staged;
+	char *filename;
+	char *err_name = NULL;
+	int ret = MM_ERROR_NONE;
+	int i;
+
+	memset(int_name, 0, sizeof(int_name));
+	memset(int_value, 0, sizeof(int_value));
+	memset(double_name, 0, sizeof(double_name));
+	memset(double_value, 0, sizeof(double_value));
+
+	// take the staged set over, values staged from now on wait for the next flush
+	g_mutex_lock(&handle->async_lock);
+	staged = handle->attr_staged;
+	memcpy(staged_value, handle->attr_staged_value, sizeof(staged_value));
+	filename = handle->staged_filename;
+	handle->attr_staged = 0;
+	handle->staged_filename = NULL;
+	g_mutex_unlock(&handle->async_lock);
+
+	for( i = 0 ; i < _RECORDER_ATTR_NUM ; i++ ){
+		if( !(staged & (1 << i)) )
+			continue;
+		if( i < _RECORDER_ATTR_INT_NUM ){
+			int_name[int_count] = __recorder_attr_name[i];
+			int_value[int_count] = staged_value[i].value_int;
+			int_count++;
+		}else{
+			double_name[double_count] = __recorder_attr_name[i];
+			double_value[double_count] = staged_value[i].value_double;
+			double_count++;
+		}
+	}
+
+	/*
+	 * one call for the whole set, the core checks every pair before applying any of them.
+	 * The list ends at the first NULL name, so doubles go before the partly used int slots
+	 * and a single double fills both of its slots.
+	 */
+	if( double_count == 1 ){
+		double_name[1] = double_name[0];
+		double_value[1] = double_value[0];
+	}
+	if( double_count > 0 && filename ){
+		ret = mm_camcorder_set_attributes(handle->mm_handle, &err_name,
+																	MMCAM_TARGET_FILENAME, filename, strlen(filename),
+																	__RECORDER_ATTR_DOUBLE_ARGS(double_name, double_value),
+																	__RECORDER_ATTR_INT_ARGS(int_name, int_value),
+																	(void*)NULL);
+	}else if( double_count > 0 ){
+		ret = mm_camcorder_set_attributes(handle->mm_handle, &err_name,
+																	__RECORDER_ATTR_DOUBLE_ARGS(double_name, double_value),
+																	__RECORDER_ATTR_INT_ARGS(int_name, int_value),
+																	(void*)NULL);
+	}else if( filename ){
+		ret = mm_camcorder_set_attributes(handle->mm_handle, &err_name,
+																	MMCAM_TARGET_FILENAME, filename, strlen(filename),
+																	__RECORDER_ATTR_INT_ARGS(int_name, int_value),
+																	(void*)NULL);
+	}else if( int_count > 0 ){
+		ret = mm_camcorder_set_attributes(handle->mm_handle, &err_name,
+																	__RECORDER_ATTR_INT_ARGS(int_name, int_value),
+																	(void*)NULL);
+	}
+
+	// the speculative pipeline may have been built with the previous values
+	if( handle->speculative && (staged & _RECORDER_ATTR_REALIZE_MASK) )
+		handle->speculative_stale = true;
+
+	if( ret == MM_ERROR_NONE ){
+		for( i = 0 ; i < _RECORDER_ATTR_NUM ; i++ ){
+			if( staged & (1 << i) )
+				handle->attr_cache[i] = staged_value[i];
+		}
+		handle->attr_cache_valid |= staged;
+	}else{
+		// the core may still have adjusted some of them, read them again
+		handle->attr_cache_valid &= ~staged;
+	}
+	if( filename )
+		free(filename);
+
+	if( ret != MM_ERROR_NONE && err_name ){
+		LOGE("[%s] attribute [%s] is rejected by core frameworks(0x%08x)", __func__, err_name, ret);
+	}
+	if( error_attr ){
+		*error_attr = err_name;
+	}else if( err_name ){
+		free(err_name);
+	}
+
+	return ret;
+}
+
+/*
+ * flushes staged attributes right away unless a transaction is open.
+ * While recorder_commit_async() finalizes the previous take, values stay staged until the commit is over
+ * and are flushed by the next setter or recorder_start(), which reports a rejection by the core (see the header).
+ */
+static int __recorder_attr_apply(recorder_s *handle, const char *func){
+	if( handle->attr_transaction )
+		return RECORDER_ERROR_NONE;
+	if( g_atomic_int_get(&handle->commit_pending) )
+		return RECORDER_ERROR_NONE;
+	return __convert_recorder_error_code(func, __recorder_attr_flush(handle, NULL));
+}
+
+/*
+ * Codec and container compatibility
+ * Bit masks of the CAPI codecs each CAPI file format can carry.
+ * MP4 and 3GP are always written with a single index at commit : the core muxer has no attribute
+ * for movie fragments, so fragmented output can not be selected from this layer.
+ */
+#define __RECORDER_CODEC_BIT(codec)	(1 << (codec))
+
+static const unsigned char __recorder_audio_compat[RECORDER_FILE_FORMAT_WAV + 1] = {
+	[RECORDER_FILE_FORMAT_3GP] = __RECORDER_CODEC_BIT(RECORDER_AUDIO_CODEC_AMR) | __RECORDER_CODEC_BIT(RECORDER_AUDIO_CODEC_AAC),
+	[RECORDER_FILE_FORMAT_MP4] = __RECORDER_CODEC_BIT(RECORDER_AUDIO_CODEC_AAC),
+	[RECORDER_FILE_FORMAT_AMR] = __RECORDER_CODEC_BIT(RECORDER_AUDIO_CODEC_AMR),
+	[RECORDER_FILE_FORMAT_ADTS] = __RECORDER_CODEC_BIT(RECORDER_AUDIO_CODEC_AAC),
+	[RECORDER_FILE_FORMAT_WAV] = __RECORDER_CODEC_BIT(RECORDER_AUDIO_CODEC_PCM),
+};
+
+static const unsigned char __recorder_video_compat[RECORDER_FILE_FORMAT_WAV + 1] = {
+	[RECORDER_FILE_FORMAT_3GP] = __RECORDER_CODEC_BIT(RECORDER_VIDEO_CODEC_H263) | __RECORDER_CODEC_BIT(RECORDER_VIDEO_CODEC_H264) | __RECORDER_CODEC_BIT(RECORDER_VIDEO_CODEC_MPEG4),
+	[RECORDER_FILE_FORMAT_MP4] = __RECORDER_CODEC_BIT(RECORDER_VIDEO_CODEC_H263) | __RECORDER_CODEC_BIT(RECORDER_VIDEO_CODEC_H264) | __RECORDER_CODEC_BIT(RECORDER_VIDEO_CODEC_MPEG4),
+};
+
+typedef char __recorder_audio_compat_check[(RECORDER_AUDIO_CODEC_PCM < 8) ? 1 : -1];
+typedef char __recorder_video_compat_check[(RECORDER_VIDEO_CODEC_THEORA < 8) ? 1 : -1];
+
+bool recorder_is_audio_encoder_compatible(recorder_file_format_e format, recorder_audio_codec_e codec){
+	if( format < RECORDER_FILE_FORMAT_3GP || format > RECORDER_FILE_FORMAT_WAV )
+		return false;
+	if( codec == RECORDER_AUDIO_CODEC_DISABLE )
+		return true;
+	if( codec < RECORDER_AUDIO_CODEC_AMR || codec > RECORDER_AUDIO_CODEC_PCM )
+		return false;
+	return (__recorder_audio_compat[format] & __RECORDER_CODEC_BIT(codec)) != 0;
+}
+
+bool recorder_is_video_encoder_compatible(recorder_file_format_e format, recorder_video_codec_e codec){
+	if( format < RECORDER_FILE_FORMAT_3GP || format > RECORDER_FILE_FORMAT_WAV )
+		return false;
+	if( codec < RECORDER_VIDEO_CODEC_H263 || codec > RECORDER_VIDEO_CODEC_THEORA )
+		return false;
+	return (__recorder_video_compat[format] & __RECORDER_CODEC_BIT(codec)) != 0;
+}
+
+/* staged value if any, otherwise the applied one */
+static int __recorder_attr_get_effective_int(recorder_s *handle, _recorder_attr_e attr, int *value){
+	bool staged;
+
+	g_mutex_lock(&handle->async_lock);
+	staged = (handle->attr_staged & (1 << attr)) != 0;
+	if( staged )
+		*value = handle->attr_staged_value[attr].value_int;
+	g_mutex_unlock(&handle->async_lock);
+
+	if( staged )
+		return MM_ERROR_NONE;
+	return __recorder_attr_get_int(handle, attr, value);
+}
+
+/*
+ * of a format and an encoder that do not match, the one staged for the flush is at fault.
+ * The encoder is reported when both or none of them are staged.
+ */
+static const char *__recorder_compatibility_fault(recorder_s *handle, _recorder_attr_e codec_attr){
+	unsigned int staged;
+
+	g_mutex_lock(&handle->async_lock);
+	staged = handle->attr_staged;
+	g_mutex_unlock(&handle->async_lock);
+
+	if( (staged & (1 << _RECORDER_ATTR_FILE_FORMAT)) && !(staged & (1 << codec_attr)) )
+		return __recorder_attr_name[_RECORDER_ATTR_FILE_FORMAT];
+	return __recorder_attr_name[codec_attr];
+}
+
+/*
+ * checks the file format against the encoders which would be in effect after a flush,
+ * values unknown to CAPI are left to the core.
+ * Returns true if they match, otherwise fault is set to the name of the attribute at fault when not NULL.
+ */
+static bool __recorder_check_compatibility(recorder_s *handle, const char *func, const char **fault){
+	int mm_format;
+	int audio_disable = 0;
+	int mm_codec;
+	int format;
+	int codec;
+
+	if( __recorder_attr_get_effective_int(handle, _RECORDER_ATTR_FILE_FORMAT, &mm_format) != MM_ERROR_NONE )
+		return true;
+	format = __recorder_file_format_from_mm(mm_format);
+	if( format < 0 )
+		return true;
+
+	__recorder_attr_get_effective_int(handle, _RECORDER_ATTR_AUDIO_DISABLE, &audio_disable);
+	if( !audio_disable && __recorder_attr_get_effective_int(handle, _RECORDER_ATTR_AUDIO_ENCODER, &mm_codec) == MM_ERROR_NONE ){
+		codec = __recorder_audio_codec_from_mm(mm_codec);
+		if( codec >= 0 && !recorder_is_audio_encoder_compatible(format, codec) ){
+			LOGE("[%s] audio codec(%d) can not be stored in file format(%d)", func, codec, format);
+			if( fault )
+				*fault = __recorder_compatibility_fault(handle, _RECORDER_ATTR_AUDIO_ENCODER);
+			return false;
+		}
+	}
+
+	if( handle->type == _RECORDER_TYPE_VIDEO && __recorder_attr_get_effective_int(handle, _RECORDER_ATTR_VIDEO_ENCODER, &mm_codec) == MM_ERROR_NONE ){
+		codec = __recorder_video_codec_from_mm(mm_codec);
+		if( codec >= 0 && !recorder_is_video_encoder_compatible(format, codec) ){
+			LOGE("[%s] video codec(%d) can not be stored in file format(%d)", func, codec, format);
+			if( fault )
+				*fault = __recorder_compatibility_fault(handle, _RECORDER_ATTR_VIDEO_ENCODER);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Startup latency
+ * Points are only taken once per take, the pending mask keeps the per buffer cost to an atomic read.
+ * A take is counted when the start call returns successfully.
+ */
+static void __recorder_latency_begin(recorder_s *handle){
+	g_mutex_lock(&handle->latency_lock);
+	memset(handle->latency_mark, 0, sizeof(handle->latency_mark));
+	handle->latency_mark[_RECORDER_LATENCY_START] = g_get_monotonic_time();
+	g_atomic_int_set(&handle->latency_pending, ((1 << _RECORDER_LATENCY_NUM) - 1) & ~(1 << _RECORDER_LATENCY_START));
+	g_mutex_unlock(&handle->latency_lock);
+}
+
+static void __recorder_latency_mark(recorder_s *handle, _recorder_latency_e point){
+	_recorder_latency_e other = point == _RECORDER_LATENCY_BUFFER ? _RECORDER_LATENCY_STATUS : _RECORDER_LATENCY_BUFFER;
+	bool first_sample;
+
+	if( !(g_atomic_int_get(&handle->latency_pending) & (1 << point)) )
+		return;
+
+	g_mutex_lock(&handle->latency_lock);
+	if( handle->latency_pending & (1 << point) ){
+		handle->latency_mark[point] = g_get_monotonic_time();
+		if( point == _RECORDER_LATENCY_RETURN )
+			handle->latency_take_count++;
+		first_sample = (point == _RECORDER_LATENCY_BUFFER || point == _RECORDER_LATENCY_STATUS) && handle->latency_mark[other] == 0;
+		if( first_sample && handle->latency_mark[point] - handle->latency_mark[_RECORDER_LATENCY_START] > handle->latency_worst )
+			handle->latency_worst = (int)(handle->latency_mark[point] - handle->latency_mark[_RECORDER_LATENCY_START]);
+		g_atomic_int_set(&handle->latency_pending, handle->latency_pending & ~(1 << point));
+	}
+	g_mutex_unlock(&handle->latency_lock);
+}
+
+static int __recorder_latency_since_start(recorder_s *handle, _recorder_latency_e point){
+	if( handle->latency_mark[point] == 0 || handle->latency_mark[_RECORDER_LATENCY_START] == 0 )
+		return -1;
+	return (int)(handle->latency_mark[point] - handle->latency_mark[_RECORDER_LATENCY_START]);
+}
+
+int recorder_get_start_latency(recorder_h recorder, recorder_start_latency_s *latency){
+	if( recorder == NULL || latency == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s *handle = (recorder_s*)recorder;
+
+	g_mutex_lock(&handle->latency_lock);
+	latency->take_count = handle->latency_take_count;
+	latency->call_time = __recorder_latency_since_start(handle, _RECORDER_LATENCY_RETURN);
+	latency->state_changed_time = __recorder_latency_since_start(handle, _RECORDER_LATENCY_STATE);
+	latency->first_buffer_time = __recorder_latency_since_start(handle, _RECORDER_LATENCY_BUFFER);
+	latency->first_status_time = __recorder_latency_since_start(handle, _RECORDER_LATENCY_STATUS);
+	latency->first_sample_time = latency->first_buffer_time;
+	if( latency->first_sample_time < 0 || (latency->first_status_time >= 0 && latency->first_status_time < latency->first_sample_time) )
+		latency->first_sample_time = latency->first_status_time;
+	latency->worst_first_sample_time = handle->latency_take_count > 0 ? handle->latency_worst : -1;
+	g_mutex_unlock(&handle->latency_lock);
+
+	return RECORDER_ERROR_NONE;
+}
+
+/* the core has closed the take by itself, the stages begun by recorder_start() are ended here instead of by recorder_commit() */
+static void __recorder_take_stopped(recorder_s *handle){
+	_recorder_prealloc_end(handle);
+	// a write error has been reported to recorder_error_cb() already
+	_recorder_writer_end(handle, false);
+	_recorder_sink_end(handle);
 }
 
 static int __mm_recorder_msg_cb(int message, void *param, void *user_data){
@@ -206,14 +759,27 @@ static int __mm_recorder_msg_cb(int message, void *param, void *user_data){
 		case MM_MESSAGE_CAMCORDER_STATE_CHANGED:
 		case MM_MESSAGE_CAMCORDER_STATE_CHANGED_BY_ASM:
 		case MM_MESSAGE_CAMCORDER_STATE_CHANGED_BY_SECURITY:
+				// the idle policy releases and prepares again a recorder which stays READY for the application
+				if( message == MM_MESSAGE_CAMCORDER_STATE_CHANGED && _recorder_idle_is_released(handle) ){
+					__recorder_attr_cache_drop(handle, _RECORDER_ATTR_CORE_ADJUSTED_MASK);
+					break;
+				}
 				previous_state = handle->state;
 				handle->state = __recorder_state_convert(m->state.current);
+				// the core may have adjusted values while building or tearing down the pipeline
+				__recorder_attr_cache_drop(handle, _RECORDER_ATTR_CORE_ADJUSTED_MASK);
+				if( handle->state == RECORDER_STATE_RECORDING )
+					__recorder_latency_mark(handle, _RECORDER_LATENCY_STATE);
 				recorder_policy_e policy = RECORDER_POLICY_NONE;
 				if(message == MM_MESSAGE_CAMCORDER_STATE_CHANGED_BY_ASM )
 					policy = RECORDER_POLICY_SOUND;
 				else if( message == MM_MESSAGE_CAMCORDER_STATE_CHANGED_BY_SECURITY )
 					policy = RECORDER_POLICY_SECURITY;
 
+				if( policy != RECORDER_POLICY_NONE && (previous_state == RECORDER_STATE_RECORDING || previous_state == RECORDER_STATE_PAUSED) &&
+					handle->state != RECORDER_STATE_RECORDING && handle->state != RECORDER_STATE_PAUSED )
+					__recorder_take_stopped(handle);
+
 				if( previous_state != handle->state && handle->user_cb[_RECORDER_EVENT_TYPE_STATE_CHANGE] ){
 					((recorder_state_changed_cb)handle->user_cb[_RECORDER_EVENT_TYPE_STATE_CHANGE])(previous_state, handle->state, policy , handle->user_data[_RECORDER_EVENT_TYPE_STATE_CHANGE]);
 				}
@@ -222,7 +788,14 @@ static int __mm_recorder_msg_cb(int message, void *param, void *user_data){
 					if( previous_state != handle->state && handle->user_cb[_RECORDER_EVENT_TYPE_INTERRUPTED] ){
 						((recorder_interrupted_cb)handle->user_cb[_RECORDER_EVENT_TYPE_INTERRUPTED])(policy, previous_state, handle->state, handle->user_data[_RECORDER_EVENT_TYPE_INTERRUPTED]);
 					}
-					if( m->state.previous == MM_CAMCORDER_STATE_PREPARE && m->state.current == MM_CAMCORDER_STATE_PREPARE ){
+					if( policy == RECORDER_POLICY_SOUND && handle->resume_timeout > 0 ){
+						// the pipeline is kept for the resume, which runs on the worker out of the core message thread
+						if( previous_state == RECORDER_STATE_RECORDING && handle->state != RECORDER_STATE_RECORDING ){
+							handle->interrupted_at = g_get_monotonic_time();
+							if( _recorder_async_resume(handle, __recorder_auto_resume) != RECORDER_ERROR_NONE )
+								LOGW("[%s] auto resume can not be queued", __func__);
+						}
+					}else if( m->state.previous == MM_CAMCORDER_STATE_PREPARE && m->state.current == MM_CAMCORDER_STATE_PREPARE ){
 						mm_camcorder_unrealize(handle->mm_handle);
 					}
 				}
@@ -233,6 +806,9 @@ static int __mm_recorder_msg_cb(int message, void *param, void *user_data){
 		case MM_MESSAGE_CAMCORDER_TIME_LIMIT:
 			{
 				recorder_recording_limit_type_e type ;
+				// in loop recording the time limit only closes the segment
+				if( message == MM_MESSAGE_CAMCORDER_TIME_LIMIT && _recorder_loop_limit_reached(handle) )
+					break;
 				if( MM_MESSAGE_CAMCORDER_MAX_SIZE == message )
 					type = RECORDER_RECORDING_LIMIT_SIZE;
 				else if( MM_MESSAGE_CAMCORDER_NO_FREE_SPACE == message)
@@ -245,6 +821,9 @@ static int __mm_recorder_msg_cb(int message, void *param, void *user_data){
 			}			
 			break;
 		case MM_MESSAGE_CAMCORDER_RECORDING_STATUS:
+			__recorder_latency_mark(handle, _RECORDER_LATENCY_STATUS);
+			if( handle->group_status_cb )
+				handle->group_status_cb(m->recording_status.elapsed, m->recording_status.filesize, handle->group_status_data);
 			if( handle->user_cb[_RECORDER_EVENT_TYPE_RECORDING_STATUS] ){
 				((recorder_recording_status_cb)handle->user_cb[_RECORDER_EVENT_TYPE_RECORDING_STATUS])( m->recording_status.elapsed, m->recording_status.filesize, handle->user_data[_RECORDER_EVENT_TYPE_RECORDING_STATUS]);
 			}
@@ -294,6 +873,11 @@ static int __mm_recorder_msg_cb(int message, void *param, void *user_data){
 					recorder_error = RECORDER_ERROR_OUT_OF_MEMORY;
 					break;
 			}
+			// a take the core could not go on with is not committed by the application
+			MMCamcorderStateType mmstate;
+			mm_camcorder_get_state(handle->mm_handle, &mmstate);
+			if( mmstate != MM_CAMCORDER_STATE_RECORDING && mmstate != MM_CAMCORDER_STATE_PAUSED )
+				__recorder_take_stopped(handle);
 			if( recorder_error != 0 && handle->user_cb[_RECORDER_EVENT_TYPE_ERROR] )
 				((recorder_error_cb)handle->user_cb[_RECORDER_EVENT_TYPE_ERROR])(errorcode, handle->state , handle->user_data[_RECORDER_EVENT_TYPE_ERROR]);
 			break;
@@ -313,6 +897,7 @@ static int __mm_audio_stream_cb(MMCamcorderAudioStreamDataType *stream, void *us
 
 	recorder_s * handle = (recorder_s*)user_param;
 	audio_sample_type_e format = AUDIO_SAMPLE_TYPE_U8;
+	__recorder_latency_mark(handle, _RECORDER_LATENCY_BUFFER);
 	if( stream->format == MM_CAMCORDER_AUDIO_FORMAT_PCM_S16_LE)
 		format = AUDIO_SAMPLE_TYPE_S16_LE;
 
@@ -360,6 +945,9 @@ int recorder_create_videorecorder( camera_h camera, recorder_h* recorder){
 	_camera_set_relay_mm_message_callback(camera, __mm_recorder_msg_cb , (void*)handle);
 
 	handle->type = _RECORDER_TYPE_VIDEO;
+	_recorder_async_init(handle);
+	g_mutex_init(&handle->latency_lock);
+	handle->prealloc_fd = -1;
 	*recorder = (recorder_h)handle;
 
 	preview_format = MM_PIXEL_FORMAT_YUYV;
@@ -372,6 +960,7 @@ int recorder_create_videorecorder( camera_h camera, recorder_h* recorder){
 																MMCAM_MODE , MM_CAMCORDER_MODE_VIDEO,
 																MMCAM_CAMERA_FORMAT, preview_format,
 																(void*)NULL);
+	__recorder_attr_cache_fill(handle);
 	return __convert_recorder_error_code(__func__, ret);
 	
 }
@@ -412,10 +1001,16 @@ int recorder_create_audiorecorder( recorder_h* recorder){
 	}
 
 
+	__recorder_attr_cache_fill(handle);
+
 	handle->state = RECORDER_STATE_CREATED;
 	mm_camcorder_set_message_callback(handle->mm_handle, __mm_recorder_msg_cb, (void*)handle);
 	handle->camera = NULL;
 	handle->type = _RECORDER_TYPE_AUDIO;
+	_recorder_async_init(handle);
+	g_mutex_init(&handle->latency_lock);
+	handle->prealloc_fd = -1;
+	_recorder_async_realize(handle);
 
 	*recorder = (recorder_h)handle;
 
@@ -435,6 +1030,9 @@ int recorder_get_state(recorder_h recorder, recorder_state_e * state){
 	recorder_state_e capi_state;
 	mm_camcorder_get_state(handle->mm_handle, &mmstate);	
 	capi_state = __recorder_state_convert(mmstate);
+	// a pipeline released by the idle policy is prepared again on demand
+	if( capi_state == RECORDER_STATE_CREATED && _recorder_idle_is_released(handle) )
+		capi_state = RECORDER_STATE_READY;
 
 	*state = capi_state;
 	return CAMERA_ERROR_NONE;
@@ -448,6 +1046,13 @@ int recorder_destroy( recorder_h recorder){
 	int ret;
 
 	handle = (recorder_s *) recorder;
+	_recorder_async_flush(handle);
+	_recorder_idle_disarm(handle);
+	if( handle->speculative ){
+		mm_camcorder_unrealize(handle->mm_handle);
+		handle->speculative = false;
+	}
+
 	if( handle->type == _RECORDER_TYPE_VIDEO ){
 		//camera object mode change
 		ret = mm_camcorder_set_attributes(handle->mm_handle, NULL,
@@ -462,8 +1067,17 @@ int recorder_destroy( recorder_h recorder){
 		ret = mm_camcorder_destroy(handle->mm_handle);
 	}
 
-	if(ret == MM_ERROR_NONE)
+	if(ret == MM_ERROR_NONE){
+		__recorder_attr_clear_staged(handle);
+		_recorder_loop_destroy(handle);
+		_recorder_sink_destroy(handle);
+		_recorder_writer_destroy(handle);
+		_recorder_prealloc_end(handle);
+		g_cond_clear(&handle->async_cond);
+		g_mutex_clear(&handle->async_lock);
+		g_mutex_clear(&handle->latency_lock);
 		free(handle);
+	}
 
 	return __convert_recorder_error_code(__func__, ret);
 
@@ -475,8 +1089,26 @@ int recorder_prepare( recorder_h recorder){
  	int ret = 0;
 	recorder_s *handle = (recorder_s*)recorder;
 
+	_recorder_async_abort_resume(handle);
+	/* an invalid combination would only fail after the costly pipeline build */
+	if( !__recorder_check_compatibility(handle, __func__, NULL) )
+		return RECORDER_ERROR_INVALID_OPERATION;
+
 	if( handle->type == _RECORDER_TYPE_VIDEO ){
-		return __convert_error_code_camera_to_recorder(camera_start_preview(handle->camera));
+		ret = camera_start_preview(handle->camera);
+		__recorder_attr_cache_drop(handle, _RECORDER_ATTR_CORE_ADJUSTED_MASK);
+		return __convert_error_code_camera_to_recorder(ret);
+	}
+
+	_recorder_idle_disarm(handle);
+	if( handle->speculative ){
+		_recorder_async_wait_realize(handle);
+		if( handle->speculative_stale ){
+			LOGI("[%s] attributes changed after the speculative realize, realize again", __func__);
+			mm_camcorder_unrealize(handle->mm_handle);
+		}
+		handle->speculative = false;
+		handle->speculative_stale = false;
 	}
 
 	MMCamcorderStateType mmstate ;
@@ -490,71 +1122,414 @@ int recorder_prepare( recorder_h recorder){
 		}
 	}
 
-	ret = mm_camcorder_start(handle->mm_handle);
+	ret = mm_camcorder_start(handle->mm_handle);
+
+	if( ret != MM_ERROR_NONE){
+		LOGE("[%s] mm_camcorder_start fail", __func__);	
+		mm_camcorder_unrealize(handle->mm_handle);
+		return __convert_recorder_error_code(__func__, ret);
+	}
+	__recorder_attr_cache_drop(handle, _RECORDER_ATTR_CORE_ADJUSTED_MASK);	
+
+	_recorder_idle_arm(handle);
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_unprepare( recorder_h recorder){
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);	
+ 	int ret = 0;
+	recorder_s *handle = (recorder_s*)recorder;
+
+	_recorder_async_abort_resume(handle);
+
+	if( handle->speculative ){
+		_recorder_async_wait_realize(handle);
+		handle->speculative = false;
+	}
+	// already unrealized by the idle policy
+	if( _recorder_idle_disarm(handle) )
+		return RECORDER_ERROR_NONE;
+
+	MMCamcorderStateType mmstate ;
+	mm_camcorder_get_state(handle->mm_handle, &mmstate);	
+	
+	if( mmstate ==  MM_CAMCORDER_STATE_PREPARE){
+		ret = mm_camcorder_stop(handle->mm_handle);	
+		if( ret != MM_ERROR_NONE){
+			LOGE("[%s] mm_camcorder_stop fail", __func__);	
+			return __convert_recorder_error_code(__func__, ret);
+		}
+	}
+	ret = mm_camcorder_unrealize(handle->mm_handle);
+	return __convert_recorder_error_code(__func__, ret);
+}
+
+/* prepares again a pipeline released by the idle policy, the added latency is reported in the idle statistics */
+static int __recorder_idle_reacquire(recorder_s *handle){
+	gint64 begin;
+	int ret;
+
+	if( !_recorder_idle_reacquire_begin(handle) )
+		return RECORDER_ERROR_NONE;
+
+	begin = g_get_monotonic_time();
+	ret = recorder_prepare((recorder_h)handle);
+	_recorder_idle_disarm(handle);
+	_recorder_idle_reacquire_end(handle, ret == RECORDER_ERROR_NONE, (int)((g_get_monotonic_time() - begin) / G_TIME_SPAN_MILLISECOND));
+
+	return ret;
+}
+
+/*
+ * Starts a take from the prepared pipeline : applies the staged values, begins the output stages
+ * and records. @a filename is the explicit file of the take, NULL keeps the configured one.
+ * On failure every stage begun here is ended and the idle policy is armed again.
+ */
+static int __recorder_take_begin(recorder_s *handle, const char *filename, const char *func){
+	int ret = RECORDER_ERROR_NONE;
+
+	if( !handle->attr_transaction ){
+		// the explicit file of the take wins over a staged one
+		if( filename ){
+			char *staged_filename;
+
+			g_mutex_lock(&handle->async_lock);
+			staged_filename = handle->staged_filename;
+			handle->staged_filename = NULL;
+			g_mutex_unlock(&handle->async_lock);
+			if( staged_filename )
+				free(staged_filename);
+		}
+		if( __recorder_attr_has_staged(handle) ){
+			ret = __recorder_attr_flush(handle, NULL);
+			if( ret != MM_ERROR_NONE ){
+				_recorder_idle_arm(handle);
+				return __convert_recorder_error_code(func, ret);
+			}
+		}
+	}
+	MMCamcorderStateType mmstate;
+	mm_camcorder_get_state(handle->mm_handle, &mmstate);
+	if( mmstate == MM_CAMCORDER_STATE_PREPARE && (filename || handle->sink || handle->loop || handle->writer) ){
+		char *target = NULL;
+		if( handle->sink ){
+			ret = _recorder_sink_begin(handle, &target);
+		}else if( handle->loop && filename == NULL ){
+			target = _recorder_loop_first_segment(handle);
+		}else{
+			ret = _recorder_writer_begin(handle, filename, &target);
+		}
+		if( ret != RECORDER_ERROR_NONE ){
+			_recorder_idle_arm(handle);
+			return ret;
+		}
+		// internal target of the take, set on the core even while a transaction keeps the values of the application staged
+		if( target || filename ){
+			const char *path = target ? target : filename;
+			ret = mm_camcorder_set_attributes(handle->mm_handle, NULL,
+																		MMCAM_TARGET_FILENAME, path, strlen(path),
+																		(void*)NULL);
+			g_free(target);
+			if( ret != MM_ERROR_NONE ){
+				_recorder_writer_end(handle, false);
+				_recorder_sink_end(handle);
+				_recorder_idle_arm(handle);
+				return __convert_recorder_error_code(func, ret);
+			}
+		}
+	}
+
+	ret = mm_camcorder_record(handle->mm_handle);
+	if( ret != MM_ERROR_NONE ){
+		_recorder_writer_end(handle, false);
+		_recorder_sink_end(handle);
+		_recorder_idle_arm(handle);
+		return __convert_recorder_error_code(func, ret);
+	}
+
+	// running out of space fails now instead of in the middle of the take
+	ret = _recorder_prealloc_begin(handle);
+	if( ret != RECORDER_ERROR_NONE ){
+		mm_camcorder_cancel(handle->mm_handle);
+		_recorder_writer_end(handle, false);
+		_recorder_sink_end(handle);
+		_recorder_idle_arm(handle);
+		return ret;
+	}
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_start( recorder_h recorder){
+	
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
+ 	int ret;
+	recorder_s *handle = (recorder_s*)recorder;
+
+	_recorder_async_abort_resume(handle);
+	__recorder_latency_begin(handle);
+	/* the next take starts after the previous one is finalized, with the values staged meanwhile */
+	if( g_atomic_int_get(&handle->commit_pending) )
+		_recorder_async_wait(handle);
+	ret = __recorder_idle_reacquire(handle);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	ret = __recorder_take_begin(handle, NULL, __func__);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	__recorder_latency_mark(handle, _RECORDER_LATENCY_RETURN);
+	return ret;
+}
+
+int recorder_pause( recorder_h recorder){
+	
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
+	int ret;
+	recorder_s *handle = (recorder_s*)recorder;
+	_recorder_async_abort_resume(handle);
+	ret = mm_camcorder_pause(handle->mm_handle);
+
+	return __convert_recorder_error_code(__func__, ret);
+}
+
+int recorder_commit( recorder_h recorder){
+	
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
+ 	int ret;
+	recorder_s *handle = (recorder_s*)recorder;
+	_recorder_async_abort_resume(handle);
+	ret = mm_camcorder_commit(handle->mm_handle);
+	if( ret == MM_ERROR_NONE ){
+		_recorder_prealloc_end(handle);
+		// the core has finished the file, a write error of the stage still loses its tail
+		ret = _recorder_writer_end(handle, true);
+		_recorder_sink_end(handle);
+		_recorder_idle_arm(handle);
+		if( ret != RECORDER_ERROR_NONE )
+			return ret;
+	}
+	return __convert_recorder_error_code(__func__, ret);	
+}
+
+int recorder_cancel( recorder_h recorder){
+	
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
+ 	int ret;
+	recorder_s *handle = (recorder_s*)recorder;
+	_recorder_async_abort_resume(handle);
+	ret = mm_camcorder_cancel(handle->mm_handle);
+	if( ret == MM_ERROR_NONE ){
+		_recorder_prealloc_end(handle);
+		_recorder_writer_end(handle, false);
+		_recorder_sink_end(handle);
+		_recorder_idle_arm(handle);
+	}
+	return __convert_recorder_error_code(__func__, ret);	
+}
+
+/*
+ * commits the current take and records the next one into filename, the pipeline stays realized.
+ * The core can not swap the muxer of a running pipeline, so the audio produced during the commit is lost.
+ * The finalized take can not be reopened, a failure after the commit leaves the recorder READY.
+ */
+static int __recorder_take_switch(recorder_s *handle, const char *filename, bool paused){
+	char *target = NULL;
+	int ret;
+
+	ret = mm_camcorder_commit(handle->mm_handle);
+	if( ret != MM_ERROR_NONE )
+		return ret;
+	_recorder_prealloc_end(handle);
+	// a write error of the finished take has been reported to recorder_error_cb() already
+	_recorder_writer_end(handle, true);
+
+	if( _recorder_writer_begin(handle, filename, &target) != RECORDER_ERROR_NONE ){
+		_recorder_idle_arm(handle);
+		return MM_ERROR_CAMCORDER_INTERNAL;
+	}
+	if( target )
+		filename = target;
+	ret = mm_camcorder_set_attributes(handle->mm_handle, NULL,
+																MMCAM_TARGET_FILENAME, filename, strlen(filename),
+																(void*)NULL);
+	g_free(target);
+	if( ret != MM_ERROR_NONE ){
+		_recorder_writer_end(handle, false);
+		_recorder_idle_arm(handle);
+		return ret;
+	}
+
+	ret = mm_camcorder_record(handle->mm_handle);
+	if( ret == MM_ERROR_NONE ){
+		__recorder_latency_mark(handle, _RECORDER_LATENCY_RETURN);
+		// the previous file is already closed, a space shortage is left to the core limit message
+		_recorder_prealloc_begin(handle);
+	}else{
+		_recorder_writer_end(handle, false);
+		_recorder_idle_arm(handle);
+	}
+	if( ret == MM_ERROR_NONE && paused )
+		ret = mm_camcorder_pause(handle->mm_handle);
+
+	return ret;
+}
+
+int recorder_split(recorder_h recorder, const char *next_filename){
+	if( recorder == NULL || next_filename == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s *handle = (recorder_s*)recorder;
+	MMCamcorderStateType mmstate;
+
+	_recorder_async_abort_resume(handle);
+	mm_camcorder_get_state(handle->mm_handle, &mmstate);
+	if( mmstate != MM_CAMCORDER_STATE_RECORDING && mmstate != MM_CAMCORDER_STATE_PAUSED ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x)", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+	if( handle->sink ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : output callbacks deliver a single file", __func__, RECORDER_ERROR_INVALID_OPERATION);
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+
+	__recorder_latency_begin(handle);
+	return __convert_recorder_error_code(__func__, __recorder_take_switch(handle, next_filename, mmstate == MM_CAMCORDER_STATE_PAUSED));
+}
+
+int recorder_start_next_take(recorder_h recorder, const char *filename){
+	if( recorder == NULL || filename == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s *handle = (recorder_s*)recorder;
+	MMCamcorderStateType mmstate;
+	int ret;
+
+	if( handle->sink ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : output callbacks deliver a single file", __func__, RECORDER_ERROR_INVALID_OPERATION);
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+	_recorder_async_abort_resume(handle);
+	__recorder_latency_begin(handle);
+	if( g_atomic_int_get(&handle->commit_pending) )
+		_recorder_async_wait(handle);
+	ret = __recorder_idle_reacquire(handle);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+
+	mm_camcorder_get_state(handle->mm_handle, &mmstate);
+	if( mmstate == MM_CAMCORDER_STATE_RECORDING || mmstate == MM_CAMCORDER_STATE_PAUSED )
+		return __convert_recorder_error_code(__func__, __recorder_take_switch(handle, filename, false));
+
+	/* never realizes the pipeline, a released one is reported instead of silently paying for a prepare */
+	if( mmstate != MM_CAMCORDER_STATE_PREPARE ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : pipeline is not prepared", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+
+	ret = __recorder_take_begin(handle, filename, __func__);
+	if( ret == RECORDER_ERROR_NONE )
+		__recorder_latency_mark(handle, _RECORDER_LATENCY_RETURN);
+
+	return ret;
+}
+
+/*
+ * Auto resume after a sound policy interruption
+ * A paused take continues in the same file, a take closed by the core continues in a new segment
+ * and a released pipeline is prepared again. Attempts are repeated until the timeout.
+ */
+#define __RECORDER_RESUME_INTERVAL	(200 * G_TIME_SPAN_MILLISECOND)
+
+/* "<base>_<n><ext>" next to the interrupted file */
+static char *__recorder_resume_segment_name(recorder_s *handle){
+	char *current = NULL;
+	char *segment;
+	const char *ext;
+	const char *slash;
+
+	if( recorder_get_filename((recorder_h)handle, &current) != RECORDER_ERROR_NONE || current == NULL )
+		return NULL;
+
+	slash = strrchr(current, '/');
+	ext = strrchr(current, '.');
+	if( ext == NULL || (slash && ext < slash) )
+		ext = current + strlen(current);
+	segment = g_strdup_printf("%.*s_%d%s", (int)(ext - current), current, ++handle->resume_segment, ext);
+	free(current);
+
+	return segment;
+}
+
+static int __recorder_auto_resume(recorder_h recorder){
+	recorder_s *handle = (recorder_s*)recorder;
+	gint64 deadline = handle->interrupted_at + (gint64)handle->resume_timeout * G_TIME_SPAN_MILLISECOND;
+	MMCamcorderStateType mmstate;
+	char *segment = NULL;
+	int ret = RECORDER_ERROR_INVALID_STATE;
+	int gap;
+
+	while( !g_atomic_int_get(&handle->resume_abort) ){
+		mm_camcorder_get_state(handle->mm_handle, &mmstate);
+		if( mmstate == MM_CAMCORDER_STATE_PAUSED ){
+			ret = recorder_start(recorder);
+		}else if( mmstate == MM_CAMCORDER_STATE_PREPARE ){
+			if( segment == NULL )
+				segment = __recorder_resume_segment_name(handle);
+			ret = segment ? recorder_start_next_take(recorder, segment) : RECORDER_ERROR_OUT_OF_MEMORY;
+		}else if( mmstate == MM_CAMCORDER_STATE_RECORDING ){
+			ret = RECORDER_ERROR_NONE;
+		}else{
+			ret = recorder_prepare(recorder);
+			if( ret == RECORDER_ERROR_NONE )
+				continue;
+		}
+		if( ret == RECORDER_ERROR_NONE || g_get_monotonic_time() >= deadline )
+			break;
+		g_usleep(__RECORDER_RESUME_INTERVAL);
+	}
+
+	if( g_atomic_int_get(&handle->resume_abort) && ret != RECORDER_ERROR_NONE ){
+		g_free(segment);
+		return ret;
+	}
 
-	if( ret != MM_ERROR_NONE){
-		LOGE("[%s] mm_camcorder_start fail", __func__);	
-		mm_camcorder_unrealize(handle->mm_handle);
-		return __convert_recorder_error_code(__func__, ret);
-	}	
+	gap = (int)((g_get_monotonic_time() - handle->interrupted_at) / G_TIME_SPAN_MILLISECOND);
+	if( ret == RECORDER_ERROR_NONE )
+		LOGI("[%s] recording resumed after %d ms into [%s]", __func__, gap, segment ? segment : "the same file");
+	else
+		LOGE("[%s] recording is not resumed in %d ms(0x%08x)", __func__, gap, ret);
+	// recorder_auto_resumed_cb() is invoked by the job once the slot is free
+	handle->resume_filename = segment;
+	handle->resume_gap = gap;
+	handle->resume_report = true;
 
-	return RECORDER_ERROR_NONE;
+	return ret;
 }
 
-int recorder_unprepare( recorder_h recorder){
-	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);	
- 	int ret = 0;
+int recorder_set_auto_resume(recorder_h recorder, int timeout){
+	if( recorder == NULL || timeout < 0 ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s *handle = (recorder_s*)recorder;
 
-	MMCamcorderStateType mmstate ;
-	mm_camcorder_get_state(handle->mm_handle, &mmstate);	
-	
-	if( mmstate ==  MM_CAMCORDER_STATE_PREPARE){
-		ret = mm_camcorder_stop(handle->mm_handle);	
-		if( ret != MM_ERROR_NONE){
-			LOGE("[%s] mm_camcorder_stop fail", __func__);	
-			return __convert_recorder_error_code(__func__, ret);
-		}
-	}
-	ret = mm_camcorder_unrealize(handle->mm_handle);
-	return __convert_recorder_error_code(__func__, ret);
-}
+	handle->resume_timeout = timeout;
+	if( timeout == 0 )
+		_recorder_async_abort_resume(handle);
 
-int recorder_start( recorder_h recorder){
-	
-	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
- 	int ret;
-	recorder_s *handle = (recorder_s*)recorder;
-	ret = mm_camcorder_record(handle->mm_handle);
-	return __convert_recorder_error_code(__func__, ret);
+	return RECORDER_ERROR_NONE;
 }
 
-int recorder_pause( recorder_h recorder){
-	
-	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
+int recorder_set_auto_resumed_cb(recorder_h recorder, recorder_auto_resumed_cb callback, void *user_data){
+	if( recorder == NULL || callback == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s *handle = (recorder_s*)recorder;
-	ret = mm_camcorder_pause(handle->mm_handle);
 
-	return __convert_recorder_error_code(__func__, ret);
-}
+	handle->user_cb[_RECORDER_EVENT_TYPE_AUTO_RESUMED] = callback;
+	handle->user_data[_RECORDER_EVENT_TYPE_AUTO_RESUMED] = user_data;
 
-int recorder_commit( recorder_h recorder){
-	
-	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
- 	int ret;
-	recorder_s *handle = (recorder_s*)recorder;
-	ret = mm_camcorder_commit(handle->mm_handle);
-	return __convert_recorder_error_code(__func__, ret);	
+	return RECORDER_ERROR_NONE;
 }
 
-int recorder_cancel( recorder_h recorder){
-	
-	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
- 	int ret;
+int recorder_unset_auto_resumed_cb(recorder_h recorder){
+	if( recorder == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s *handle = (recorder_s*)recorder;
-	ret = mm_camcorder_cancel(handle->mm_handle);
-	return __convert_recorder_error_code(__func__, ret);	
+
+	handle->user_cb[_RECORDER_EVENT_TYPE_AUTO_RESUMED] = NULL;
+	handle->user_data[_RECORDER_EVENT_TYPE_AUTO_RESUMED] = NULL;
+
+	return RECORDER_ERROR_NONE;
 }
 
 int recorder_get_audio_level(recorder_h recorder, double *level){
@@ -577,10 +1552,18 @@ int recorder_set_filename(recorder_h recorder,  const char *filename){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	g_return_val_if_fail(filename != NULL, RECORDER_ERROR_INVALID_PARAMETER);			
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL,  MMCAM_TARGET_FILENAME  , filename , strlen(filename), NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	char *staged = strdup(filename);
+	if( staged == NULL ){
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __func__, RECORDER_ERROR_OUT_OF_MEMORY);
+		return RECORDER_ERROR_OUT_OF_MEMORY;
+	}
+	g_mutex_lock(&handle->async_lock);
+	if( handle->staged_filename )
+		free(handle->staged_filename);
+	handle->staged_filename = staged;
+	g_mutex_unlock(&handle->async_lock);
+	return __recorder_attr_apply(handle, __func__);
 
 }
 
@@ -591,6 +1574,14 @@ int recorder_get_filename(recorder_h recorder,  char **filename){
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
 
+	// a write-behind take is written to a pipe, the file of the take is the one of the writer
+	char *writer_path = _recorder_writer_get_path(handle);
+	if( writer_path ){
+		*filename = strdup(writer_path);
+		g_free(writer_path);
+		return *filename ? RECORDER_ERROR_NONE : RECORDER_ERROR_OUT_OF_MEMORY;
+	}
+
 	char *record_filename;
 	int record_filename_size;
 	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_TARGET_FILENAME , &record_filename, &record_filename_size, NULL);
@@ -606,20 +1597,16 @@ int recorder_get_filename(recorder_h recorder,  char **filename){
 int recorder_set_file_format(recorder_h recorder, recorder_file_format_e format){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
-	int format_table[5] = { MM_FILE_FORMAT_3GP ,  // RECORDER_FILE_FORMAT_3GP,
-											  MM_FILE_FORMAT_MP4 , //RECORDER_FILE_FORMAT_MP4,
-											  MM_FILE_FORMAT_AMR, //RECORDER_FILE_FORMAT_AMR,
-											  MM_FILE_FORMAT_AAC, //RECORDER_FILE_FORMAT_ADTS
-											  MM_FILE_FORMAT_WAV //RECORDER_FILE_FORMAT_WAV
-											};
 
-	if( format < RECORDER_FILE_FORMAT_3GP || format > RECORDER_FILE_FORMAT_WAV )
+	int mm_format = __recorder_file_format_to_mm(format);
+	if( mm_format < 0 )
 		return RECORDER_ERROR_INVALID_PARAMETER;
 
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_FILE_FORMAT  , format_table[format], NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_FILE_FORMAT, mm_format, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_FILE_FORMAT, mm_format);
+	return __recorder_attr_apply(handle, __func__);
 }
 
 int recorder_get_file_format(recorder_h recorder, recorder_file_format_e *format){
@@ -630,29 +1617,14 @@ int recorder_get_file_format(recorder_h recorder, recorder_file_format_e *format
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
 	int mm_format;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_FILE_FORMAT  , &mm_format, NULL);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_FILE_FORMAT, &mm_format);
 
 	if( ret == 0 ){
-		switch( mm_format ){
-			case MM_FILE_FORMAT_3GP:
-				*format = RECORDER_FILE_FORMAT_3GP;
-				break;
-			case MM_FILE_FORMAT_MP4 :
-				*format = RECORDER_FILE_FORMAT_MP4;
-				break;
-			case MM_FILE_FORMAT_AMR :
-				*format = RECORDER_FILE_FORMAT_AMR;
-				break;
-			case MM_FILE_FORMAT_AAC :
-				*format = RECORDER_FILE_FORMAT_ADTS;
-				break;
-			case MM_FILE_FORMAT_WAV:
-				*format = RECORDER_FILE_FORMAT_WAV;
-				break;
-			default :
-				ret = MM_ERROR_CAMCORDER_INTERNAL;
-				break;
-		}
+		int value = __recorder_file_format_from_mm(mm_format);
+		if( value < 0 )
+			ret = MM_ERROR_CAMCORDER_INTERNAL;
+		else
+			*format = value;
 	}
 	return __convert_recorder_error_code(__func__, ret);
 }
@@ -797,37 +1769,16 @@ int recorder_foreach_supported_file_format(recorder_h recorder, recorder_support
 	if( foreach_cb == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);			
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	MMCamAttrsInfo info;
-	ret = mm_camcorder_get_attribute_info(handle->mm_handle, MMCAM_FILE_FORMAT , &info);
-	if( ret != RECORDER_ERROR_NONE )
-		return ret;
+	const int *values;
+	int count;
+	ret = _recorder_capability_get(handle, _RECORDER_CAPABILITY_FILE_FORMAT, &values, &count);
+	if( ret != MM_ERROR_NONE )
+		return __convert_recorder_error_code(__func__, ret);
 	
 	int i;
-	for( i=0 ; i < info.int_array.count ; i++)
+	for( i=0 ; i < count ; i++)
 	{
-
-		int format;
-		
-		switch(  info.int_array.array[i] ){
-			case MM_FILE_FORMAT_3GP:
-				format = RECORDER_FILE_FORMAT_3GP;
-				break;
-			case MM_FILE_FORMAT_MP4 :
-				format = RECORDER_FILE_FORMAT_MP4;
-				break;
-			case MM_FILE_FORMAT_AMR :
-				format = RECORDER_FILE_FORMAT_AMR;
-				break;
-			case MM_FILE_FORMAT_AAC:
-				format = RECORDER_FILE_FORMAT_ADTS;
-				break;
-			case MM_FILE_FORMAT_WAV:
-				format = RECORDER_FILE_FORMAT_WAV;
-				break;
-			default :
-				format = -1;
-		}
-
+		int format = __recorder_file_format_from_mm(values[i]);
 		if ( format != -1 && !foreach_cb(format,user_data) )
 			break;
 	}
@@ -840,29 +1791,32 @@ int recorder_foreach_supported_file_format(recorder_h recorder, recorder_support
 int recorder_attr_set_size_limit(recorder_h recorder,  int kbyte){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, "target-max-size"  , kbyte, NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_SIZE_LIMIT, kbyte, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_SIZE_LIMIT, kbyte);
+	return __recorder_attr_apply(handle, __func__);
 	
 }
 
 int recorder_attr_set_time_limit(recorder_h recorder,  int second){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_TARGET_TIME_LIMIT , second, NULL);
-	return __convert_recorder_error_code(__func__, ret);	
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_TIME_LIMIT, second, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_TIME_LIMIT, second);
+	return __recorder_attr_apply(handle, __func__);	
 }
 
 int recorder_attr_set_audio_device(recorder_h recorder , recorder_audio_device_e device){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_DEVICE , device, NULL);
-	return __convert_recorder_error_code(__func__, ret);	
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_AUDIO_DEVICE, device, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_DEVICE, device);
+	return __recorder_attr_apply(handle, __func__);	
 }
 
 int recorder_set_audio_encoder(recorder_h recorder, recorder_audio_codec_e  codec){
@@ -872,19 +1826,18 @@ int recorder_set_audio_encoder(recorder_h recorder, recorder_audio_codec_e  code
 	if( codec != RECORDER_AUDIO_CODEC_DISABLE && ( codec < RECORDER_AUDIO_CODEC_AMR || codec > RECORDER_AUDIO_CODEC_PCM) )
 		return RECORDER_ERROR_INVALID_PARAMETER;
 
-	int audio_table[4] = { MM_AUDIO_CODEC_AMR, //RECORDER_AUDIO_CODEC_AMR
-											MM_AUDIO_CODEC_AAC,  //RECORDER_AUDIO_CODEC_AAC
-											MM_AUDIO_CODEC_VORBIS, //RECORDER_AUDIO_CODEC_VORBIS
-											MM_AUDIO_CODEC_WAVE //RECORDER_AUDIO_CODEC_PCM
-										};
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	if( codec == RECORDER_AUDIO_CODEC_DISABLE )
-		ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_DISABLE , 1, NULL);
-	else
-		ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_ENCODER , audio_table[codec], MMCAM_AUDIO_DISABLE, 0, NULL);
+	if( codec == RECORDER_AUDIO_CODEC_DISABLE ){
+		__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_DISABLE, 1);
+	}else{
+		int mm_codec = __recorder_audio_codec_to_mm(codec);
+		if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_AUDIO_ENCODER, mm_codec, __func__) )
+			return RECORDER_ERROR_INVALID_PARAMETER;
+		__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_ENCODER, mm_codec);
+		__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_DISABLE, 0);
+	}
 
-	return __convert_recorder_error_code(__func__, ret);
+	return __recorder_attr_apply(handle, __func__);
 	
 }
 
@@ -897,25 +1850,15 @@ int recorder_get_audio_encoder(recorder_h recorder, recorder_audio_codec_e *code
 	int audio_disable = 0;
 	
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_ENCODER , &mm_codec , MMCAM_AUDIO_DISABLE, &audio_disable, NULL);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_AUDIO_DISABLE, &audio_disable);
+	if( ret == 0 && audio_disable == 0 )
+		ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_AUDIO_ENCODER, &mm_codec);
 	if( ret == 0 && audio_disable == 0 ){
-		switch( mm_codec ){
-			case MM_AUDIO_CODEC_AMR :
-				*codec = RECORDER_AUDIO_CODEC_AMR;
-				break;
-			case MM_AUDIO_CODEC_AAC :
-				*codec = RECORDER_AUDIO_CODEC_AAC;
-				break;
-			case MM_AUDIO_CODEC_VORBIS:
-				*codec = RECORDER_AUDIO_CODEC_VORBIS;
-				break;
-			case MM_AUDIO_CODEC_WAVE:
-				*codec = RECORDER_AUDIO_CODEC_PCM;
-				break;
-			default :
-				ret = MM_ERROR_CAMCORDER_INTERNAL;
-				break;
-		}
+		int value = __recorder_audio_codec_from_mm(mm_codec);
+		if( value < 0 )
+			ret = MM_ERROR_CAMCORDER_INTERNAL;
+		else
+			*codec = value;
 	}else if( ret == 0 && audio_disable ){
 		*codec = RECORDER_AUDIO_CODEC_DISABLE;
 	}
@@ -926,19 +1869,16 @@ int recorder_get_audio_encoder(recorder_h recorder, recorder_audio_codec_e *code
 int recorder_set_video_encoder(recorder_h recorder, recorder_video_codec_e  codec){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 
-	int video_table[4] = { MM_VIDEO_CODEC_H263,		//RECORDER_VIDEO_CODEC_H263,			/**< H263 codec		*/
-											MM_VIDEO_CODEC_H264, 	//RECORDER_VIDEO_CODEC_H264,			/**< H264 codec		*/
-											MM_VIDEO_CODEC_MPEG4, 	//RECORDER_VIDEO_CODEC_MPEG4,			/**< MPEG4 codec	*/
-											MM_VIDEO_CODEC_THEORA //RECORDER_VIDEO_CODEC_THEORA
-										};
-	if( codec < RECORDER_VIDEO_CODEC_H263 || codec > RECORDER_VIDEO_CODEC_THEORA )
+	int mm_codec = __recorder_video_codec_to_mm(codec);
+	if( mm_codec < 0 )
 		return RECORDER_ERROR_INVALID_PARAMETER;
 	recorder_s * handle = (recorder_s*)recorder;
 
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_VIDEO_ENCODER   , video_table[codec], NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_VIDEO_ENCODER, mm_codec, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_VIDEO_ENCODER, mm_codec);
+	return __recorder_attr_apply(handle, __func__);
 }
 
 
@@ -952,25 +1892,13 @@ int recorder_get_video_encoder(recorder_h recorder, recorder_video_codec_e *code
 	int mm_codec = 0;
 
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_VIDEO_ENCODER , &mm_codec, NULL);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_VIDEO_ENCODER, &mm_codec);
 	if( ret == 0 ){
-		switch( mm_codec ){
-			case MM_VIDEO_CODEC_H263 :
-				*codec = RECORDER_VIDEO_CODEC_H263;
-				break;
-			case MM_VIDEO_CODEC_H264 :
-				*codec = RECORDER_VIDEO_CODEC_H264;
-				break;
-			case MM_VIDEO_CODEC_MPEG4 :
-				*codec = RECORDER_VIDEO_CODEC_MPEG4;
-				break;
-			case MM_VIDEO_CODEC_THEORA:
-				*codec = RECORDER_VIDEO_CODEC_THEORA;
-				break;
-			default :
-				ret = MM_ERROR_CAMCORDER_INTERNAL;
-				break;
-		}
+		int value = __recorder_video_codec_from_mm(mm_codec);
+		if( value < 0 )
+			ret = MM_ERROR_CAMCORDER_INTERNAL;
+		else
+			*codec = value;
 	}
 	
 	return __convert_recorder_error_code(__func__, ret);
@@ -980,30 +1908,33 @@ int recorder_get_video_encoder(recorder_h recorder, recorder_video_codec_e *code
 int recorder_attr_set_audio_samplerate(recorder_h recorder, int samplerate){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_SAMPLERATE  , samplerate, NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_AUDIO_SAMPLERATE, samplerate, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_SAMPLERATE, samplerate);
+	return __recorder_attr_apply(handle, __func__);
 	
 }
 
 int recorder_attr_set_audio_encoder_bitrate(recorder_h recorder,  int bitrate){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_ENCODER_BITRATE  , bitrate, NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_AUDIO_ENCODER_BITRATE, bitrate, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_ENCODER_BITRATE, bitrate);
+	return __recorder_attr_apply(handle, __func__);
 	
 }
 
 int recorder_attr_set_video_encoder_bitrate(recorder_h recorder,  int bitrate){
 	
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
-	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_VIDEO_ENCODER_BITRATE  , bitrate, NULL);
-	return __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_VIDEO_ENCODER_BITRATE, bitrate, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_VIDEO_ENCODER_BITRATE, bitrate);
+	return __recorder_attr_apply(handle, __func__);
 	
 }
 
@@ -1012,7 +1943,8 @@ int recorder_attr_get_size_limit(recorder_h recorder,  int *kbyte){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, "target-max-size"  , kbyte, NULL);
+	if( kbyte == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_SIZE_LIMIT, kbyte);
 	return __convert_recorder_error_code(__func__, ret);	
 }
 
@@ -1021,7 +1953,8 @@ int recorder_attr_get_time_limit(recorder_h recorder,  int *second){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_TARGET_TIME_LIMIT , second, NULL);
+	if( second == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_TIME_LIMIT, second);
 	return __convert_recorder_error_code(__func__, ret);
 	
 }
@@ -1031,7 +1964,8 @@ int recorder_attr_get_audio_device(recorder_h recorder , recorder_audio_device_e
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_DEVICE , device, NULL);
+	if( device == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_AUDIO_DEVICE, (int*)device);
 	return __convert_recorder_error_code(__func__, ret);	
 }
 
@@ -1042,7 +1976,8 @@ int recorder_attr_get_audio_samplerate(recorder_h recorder, int *samplerate){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_SAMPLERATE , samplerate, NULL);
+	if( samplerate == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_AUDIO_SAMPLERATE, samplerate);
 	return __convert_recorder_error_code(__func__, ret);
 	
 }
@@ -1052,7 +1987,8 @@ int recorder_attr_get_audio_encoder_bitrate(recorder_h recorder,  int *bitrate){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_ENCODER_BITRATE , bitrate, NULL);
+	if( bitrate == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_AUDIO_ENCODER_BITRATE, bitrate);
 	return __convert_recorder_error_code(__func__, ret);
 }
 
@@ -1061,7 +1997,8 @@ int recorder_attr_get_video_encoder_bitrate(recorder_h recorder,  int *bitrate){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_VIDEO_ENCODER_BITRATE , bitrate, NULL);
+	if( bitrate == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_VIDEO_ENCODER_BITRATE, bitrate);
 	return __convert_recorder_error_code(__func__, ret);
 	
 }
@@ -1072,32 +2009,16 @@ int recorder_foreach_supported_audio_encoder(recorder_h recorder, recorder_suppo
 	if( foreach_cb == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);		
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	MMCamAttrsInfo info;
-	ret = mm_camcorder_get_attribute_info(handle->mm_handle, MMCAM_AUDIO_ENCODER , &info);
-	if( ret != RECORDER_ERROR_NONE )
+	const int *values;
+	int count;
+	ret = _recorder_capability_get(handle, _RECORDER_CAPABILITY_AUDIO_ENCODER, &values, &count);
+	if( ret != MM_ERROR_NONE )
 		return __convert_recorder_error_code(__func__, ret);
 	
 	int i;
-	for( i=0 ; i < info.int_array.count ; i++)
+	for( i=0 ; i < count ; i++)
 	{
-		int codec;
-		
-		switch(  info.int_array.array[i] ){
-			case MM_AUDIO_CODEC_AMR:
-				codec = RECORDER_AUDIO_CODEC_AMR;
-				break;
-			case MM_AUDIO_CODEC_AAC :
-				codec = RECORDER_AUDIO_CODEC_AAC;
-				break;
-			case MM_AUDIO_CODEC_VORBIS:
-				codec = RECORDER_AUDIO_CODEC_VORBIS;
-				break;
-			case MM_AUDIO_CODEC_WAVE:
-				codec = RECORDER_AUDIO_CODEC_PCM;
-				break;
-			default :
-				codec = -1;
-		}	
+		int codec = __recorder_audio_codec_from_mm(values[i]);
 		if( codec != -1 && !foreach_cb(codec,user_data) )
 			break;
 	}
@@ -1109,33 +2030,16 @@ int recorder_foreach_supported_video_encoder(recorder_h recorder, recorder_suppo
 	if( foreach_cb == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	int ret;
 	recorder_s * handle = (recorder_s*)recorder;
-	MMCamAttrsInfo info;
-	ret = mm_camcorder_get_attribute_info(handle->mm_handle, MMCAM_VIDEO_ENCODER , &info);
-	if( ret != RECORDER_ERROR_NONE )
+	const int *values;
+	int count;
+	ret = _recorder_capability_get(handle, _RECORDER_CAPABILITY_VIDEO_ENCODER, &values, &count);
+	if( ret != MM_ERROR_NONE )
 		return __convert_recorder_error_code(__func__, ret);
 	
 	int i;
-	for( i=0 ; i < info.int_array.count ; i++)
+	for( i=0 ; i < count ; i++)
 	{
-		int codec;
-		
-		switch(  info.int_array.array[i] ){
-			case MM_VIDEO_CODEC_H263 :
-				codec = RECORDER_VIDEO_CODEC_H263;
-				break;
-			case MM_VIDEO_CODEC_H264 :
-				codec = RECORDER_VIDEO_CODEC_H264;
-				break;
-			case MM_VIDEO_CODEC_MPEG4 :
-				codec = RECORDER_VIDEO_CODEC_MPEG4;
-				break;
-			case MM_VIDEO_CODEC_THEORA :
-				codec = RECORDER_VIDEO_CODEC_THEORA;
-				break;
-			default :
-				codec = -1;
-		}	
-	
+		int codec = __recorder_video_codec_from_mm(values[i]);
 		if ( codec != -1 &&  !foreach_cb(codec,user_data) )
 			break;
 	}
@@ -1144,11 +2048,194 @@ int recorder_foreach_supported_video_encoder(recorder_h recorder, recorder_suppo
 }
 
 
+static int __recorder_get_supported(recorder_s *handle, _recorder_capability_e capability, int (*from_mm)(int), int *values, int *count){
+	const int *mm_values;
+	int mm_count;
+	int ret;
+	int i;
+	int n = 0;
+
+	ret = _recorder_capability_get(handle, capability, &mm_values, &mm_count);
+	if( ret != MM_ERROR_NONE )
+		return ret;
+
+	for( i = 0 ; i < mm_count ; i++ ){
+		int value = from_mm(mm_values[i]);
+		if( value == -1 )
+			continue;
+		if( n < *count )
+			values[n] = value;
+		n++;
+	}
+	*count = n;
+
+	return MM_ERROR_NONE;
+}
+
+int recorder_get_supported_file_formats(recorder_h recorder, recorder_file_format_e *formats, int *count){
+	if( recorder == NULL || count == NULL || *count < 0 || (formats == NULL && *count > 0) )
+		return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	int ret = __recorder_get_supported((recorder_s*)recorder, _RECORDER_CAPABILITY_FILE_FORMAT, __recorder_file_format_from_mm, (int*)formats, count);
+	return ret == MM_ERROR_NONE ? RECORDER_ERROR_NONE : __convert_recorder_error_code(__func__, ret);
+}
+
+int recorder_get_supported_audio_encoders(recorder_h recorder, recorder_audio_codec_e *codecs, int *count){
+	if( recorder == NULL || count == NULL || *count < 0 || (codecs == NULL && *count > 0) )
+		return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	int ret = __recorder_get_supported((recorder_s*)recorder, _RECORDER_CAPABILITY_AUDIO_ENCODER, __recorder_audio_codec_from_mm, (int*)codecs, count);
+	return ret == MM_ERROR_NONE ? RECORDER_ERROR_NONE : __convert_recorder_error_code(__func__, ret);
+}
+
+int recorder_get_supported_video_encoders(recorder_h recorder, recorder_video_codec_e *codecs, int *count){
+	if( recorder == NULL || count == NULL || *count < 0 || (codecs == NULL && *count > 0) )
+		return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	int ret = __recorder_get_supported((recorder_s*)recorder, _RECORDER_CAPABILITY_VIDEO_ENCODER, __recorder_video_codec_from_mm, (int*)codecs, count);
+	return ret == MM_ERROR_NONE ? RECORDER_ERROR_NONE : __convert_recorder_error_code(__func__, ret);
+}
+
+/* range of an int attribute, an enumerated attribute gives its smallest and largest value */
+static int __recorder_attr_get_range(recorder_s *handle, _recorder_attr_e attr, int *min, int *max, const char *func){
+	const _recorder_attr_info_s *info = __recorder_attr_info(handle, attr);
+	int i;
+
+	switch( info->validity_type ){
+		case MM_CAM_ATTRS_VALID_TYPE_INT_RANGE:
+			*min = info->int_range.min;
+			*max = info->int_range.max;
+			return RECORDER_ERROR_NONE;
+		case MM_CAM_ATTRS_VALID_TYPE_INT_ARRAY:
+			if( info->int_array.count == 0 )
+				break;
+			*min = *max = info->int_array.values[0];
+			for( i = 1 ; i < info->int_array.count ; i++ ){
+				if( info->int_array.values[i] < *min )
+					*min = info->int_array.values[i];
+				if( info->int_array.values[i] > *max )
+					*max = info->int_array.values[i];
+			}
+			return RECORDER_ERROR_NONE;
+		default:
+			break;
+	}
+	LOGE("[%s] INVALID_OPERATION(0x%08x) : range of [%s] is not provided", func, RECORDER_ERROR_INVALID_OPERATION, __recorder_attr_name[attr]);
+	return RECORDER_ERROR_INVALID_OPERATION;
+}
+
+int recorder_attr_get_audio_samplerate_range(recorder_h recorder, int *min, int *max){
+	if( recorder == NULL || min == NULL || max == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	return __recorder_attr_get_range((recorder_s*)recorder, _RECORDER_ATTR_AUDIO_SAMPLERATE, min, max, __func__);
+}
+
+int recorder_attr_get_audio_encoder_bitrate_range(recorder_h recorder, int *min, int *max){
+	if( recorder == NULL || min == NULL || max == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	return __recorder_attr_get_range((recorder_s*)recorder, _RECORDER_ATTR_AUDIO_ENCODER_BITRATE, min, max, __func__);
+}
+
+int recorder_attr_get_video_encoder_bitrate_range(recorder_h recorder, int *min, int *max){
+	if( recorder == NULL || min == NULL || max == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	return __recorder_attr_get_range((recorder_s*)recorder, _RECORDER_ATTR_VIDEO_ENCODER_BITRATE, min, max, __func__);
+}
+
+int recorder_attr_get_audio_channel_range(recorder_h recorder, int *min, int *max){
+	if( recorder == NULL || min == NULL || max == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	return __recorder_attr_get_range((recorder_s*)recorder, _RECORDER_ATTR_AUDIO_CHANNEL, min, max, __func__);
+}
+
+
+int recorder_foreach_compatible_file_format(recorder_h recorder, recorder_supported_file_format_cb foreach_cb, void *user_data){
+	if( recorder == NULL || foreach_cb == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_audio_codec_e audio_codec;
+	recorder_video_codec_e video_codec = RECORDER_VIDEO_CODEC_H263;
+	const int *values;
+	int count;
+	int ret;
+	int i;
+
+	ret = recorder_get_audio_encoder(recorder, &audio_codec);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	if( handle->type == _RECORDER_TYPE_VIDEO ){
+		ret = recorder_get_video_encoder(recorder, &video_codec);
+		if( ret != RECORDER_ERROR_NONE )
+			return ret;
+	}
+
+	ret = _recorder_capability_get(handle, _RECORDER_CAPABILITY_FILE_FORMAT, &values, &count);
+	if( ret != MM_ERROR_NONE )
+		return __convert_recorder_error_code(__func__, ret);
+
+	for( i = 0 ; i < count ; i++ ){
+		int format = __recorder_file_format_from_mm(values[i]);
+		if( format == -1 || !recorder_is_audio_encoder_compatible(format, audio_codec) )
+			continue;
+		if( handle->type == _RECORDER_TYPE_VIDEO && !recorder_is_video_encoder_compatible(format, video_codec) )
+			continue;
+		if( !foreach_cb(format, user_data) )
+			break;
+	}
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_foreach_compatible_audio_encoder(recorder_h recorder, recorder_supported_audio_encoder_cb foreach_cb, void *user_data){
+	if( recorder == NULL || foreach_cb == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_file_format_e format;
+	const int *values;
+	int count;
+	int ret;
+	int i;
+
+	ret = recorder_get_file_format(recorder, &format);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+
+	ret = _recorder_capability_get(handle, _RECORDER_CAPABILITY_AUDIO_ENCODER, &values, &count);
+	if( ret != MM_ERROR_NONE )
+		return __convert_recorder_error_code(__func__, ret);
+
+	for( i = 0 ; i < count ; i++ ){
+		int codec = __recorder_audio_codec_from_mm(values[i]);
+		if( codec == -1 || !recorder_is_audio_encoder_compatible(format, codec) )
+			continue;
+		if( !foreach_cb(codec, user_data) )
+			break;
+	}
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_foreach_compatible_video_encoder(recorder_h recorder, recorder_supported_video_encoder_cb foreach_cb, void *user_data){
+	if( recorder == NULL || foreach_cb == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_file_format_e format;
+	const int *values;
+	int count;
+	int ret;
+	int i;
+
+	ret = recorder_get_file_format(recorder, &format);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+
+	ret = _recorder_capability_get(handle, _RECORDER_CAPABILITY_VIDEO_ENCODER, &values, &count);
+	if( ret != MM_ERROR_NONE )
+		return __convert_recorder_error_code(__func__, ret);
+
+	for( i = 0 ; i < count ; i++ ){
+		int codec = __recorder_video_codec_from_mm(values[i]);
+		if( codec == -1 || !recorder_is_video_encoder_compatible(format, codec) )
+			continue;
+		if( !foreach_cb(codec, user_data) )
+			break;
+	}
+	return RECORDER_ERROR_NONE;
+}
+
 int recorder_attr_set_mute(recorder_h recorder, bool enable){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_VOLUME , enable ? 0.0 : 1.0 , NULL);
-	return  __convert_recorder_error_code(__func__, ret);
+	__recorder_attr_stage_double(handle, _RECORDER_ATTR_AUDIO_VOLUME, enable ? 0.0 : 1.0);
+	return __recorder_attr_apply(handle, __func__);
 }
 
 bool recorder_attr_is_muted(recorder_h recorder){
@@ -1158,7 +2245,7 @@ bool recorder_attr_is_muted(recorder_h recorder){
 	}
 	recorder_s * handle = (recorder_s*)recorder;
 	double volume = 1.0;
-	mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_VOLUME , &volume , NULL);
+	__recorder_attr_get_double(handle, _RECORDER_ATTR_AUDIO_VOLUME, &volume);
 	if( volume == 0.0 )
 		return true;
 	else
@@ -1168,8 +2255,10 @@ bool recorder_attr_is_muted(recorder_h recorder){
 int recorder_attr_set_recording_motion_rate(recorder_h recorder , double rate){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, "camera-recording-motion-rate" , rate, NULL);
-	return  __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_double(handle, _RECORDER_ATTR_MOTION_RATE, rate, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_double(handle, _RECORDER_ATTR_MOTION_RATE, rate);
+	return __recorder_attr_apply(handle, __func__);
 }
 
 int recorder_attr_get_recording_motion_rate(recorder_h recorder , double *rate){
@@ -1177,7 +2266,7 @@ int recorder_attr_get_recording_motion_rate(recorder_h recorder , double *rate){
 		return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, "camera-recording-motion-rate" , rate , NULL);
+	int ret = __recorder_attr_get_double(handle, _RECORDER_ATTR_MOTION_RATE, rate);
 	return  __convert_recorder_error_code(__func__, ret);
 }
 
@@ -1195,8 +2284,10 @@ int recorder_attr_get_slow_motion_rate(recorder_h recorder , double *rate){
 int recorder_attr_set_audio_channel(recorder_h recorder, int channel_count){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_CHANNEL, channel_count, NULL);
-	return  __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_AUDIO_CHANNEL, channel_count, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_AUDIO_CHANNEL, channel_count);
+	return __recorder_attr_apply(handle, __func__);
 }
 
 int recorder_attr_get_audio_channel(recorder_h recorder, int *channel_count){
@@ -1204,20 +2295,77 @@ int recorder_attr_get_audio_channel(recorder_h recorder, int *channel_count){
 		return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, MMCAM_AUDIO_CHANNEL , channel_count, NULL);
+	int ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_AUDIO_CHANNEL, channel_count);
 	return  __convert_recorder_error_code(__func__, ret);
 }
 
 int recorder_attr_set_recording_orientation(recorder_h recorder, recorder_rotation_e orientation){
 	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_set_attributes(handle->mm_handle ,NULL, "camcorder-rotation", orientation, NULL);
-	return  __convert_recorder_error_code(__func__, ret);
+	if( !__recorder_attr_check_int(handle, _RECORDER_ATTR_ORIENTATION, orientation, __func__) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	__recorder_attr_stage_int(handle, _RECORDER_ATTR_ORIENTATION, orientation);
+	return __recorder_attr_apply(handle, __func__);
 }
 
 int recorder_attr_get_recording_orientation(recorder_h recorder, recorder_rotation_e *orientation){
 	if( recorder == NULL || orientation == NULL ) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
 	recorder_s * handle = (recorder_s*)recorder;
-	int ret = mm_camcorder_get_attributes(handle->mm_handle ,NULL, "camcorder-rotation" , orientation, NULL);
+	int ret = __recorder_attr_get_int(handle, _RECORDER_ATTR_ORIENTATION, (int*)orientation);
 	return  __convert_recorder_error_code(__func__, ret);
 }
+
+int recorder_attr_begin(recorder_h recorder){
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s * handle = (recorder_s*)recorder;
+	if( handle->attr_transaction ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : transaction is already opened", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+	/* values staged while recorder_commit_async() was running are applied first, not taken into the transaction */
+	if( g_atomic_int_get(&handle->commit_pending) )
+		_recorder_async_wait(handle);
+	if( __recorder_attr_has_staged(handle) ){
+		int ret = __recorder_attr_flush(handle, NULL);
+		if( ret != MM_ERROR_NONE )
+			return __convert_recorder_error_code(__func__, ret);
+	}
+	handle->attr_transaction = true;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_attr_commit(recorder_h recorder, char **error_attribute){
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s * handle = (recorder_s*)recorder;
+	if( error_attribute )
+		*error_attribute = NULL;
+	if( !handle->attr_transaction ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : transaction is not opened", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+	handle->attr_transaction = false;
+	/* the core is committing a take on the async worker, flush after it is done */
+	if( g_atomic_int_get(&handle->commit_pending) )
+		_recorder_async_wait(handle);
+	const char *fault = NULL;
+	if( !__recorder_check_compatibility(handle, __func__, &fault) ){
+		__recorder_attr_clear_staged(handle);
+		if( error_attribute && fault )
+			*error_attribute = strdup(fault);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+	int ret = __recorder_attr_flush(handle, error_attribute);
+	return __convert_recorder_error_code(__func__, ret);
+}
+
+int recorder_attr_rollback(recorder_h recorder){
+	if( recorder == NULL) return __convert_recorder_error_code(__func__, RECORDER_ERROR_INVALID_PARAMETER);
+	recorder_s * handle = (recorder_s*)recorder;
+	if( !handle->attr_transaction ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : transaction is not opened", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+	handle->attr_transaction = false;
+	__recorder_attr_clear_staged(handle);
+	return RECORDER_ERROR_NONE;
+}
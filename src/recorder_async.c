@@ -0,0 +1,303 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <glib.h>
+#include <mm_camcorder.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Asynchronous operations
+ * A handle runs at most one job on the library worker. A job can be cancelled until the worker picks it up,
+ * the state is switched atomically so that exactly one of the worker and the canceller owns the outcome.
+ */
+typedef enum {
+	_RECORDER_ASYNC_JOB_PENDING = 0,
+	_RECORDER_ASYNC_JOB_STARTED,
+	_RECORDER_ASYNC_JOB_CANCELLED
+}_recorder_async_job_state_e;
+
+typedef struct _recorder_async_job_s {
+	recorder_s *handle;
+	int (*func)(recorder_h recorder);
+	recorder_async_completed_cb callback;
+	recorder_commit_completed_cb commit_callback;
+	recorder_auto_resumed_cb resumed_callback;
+	void *user_data;
+	char *path;		/* target file of a commit job, segment of a resume job */
+	int gap;
+	bool commit;
+	bool realize;	/* speculative realize, yields to any other job */
+	bool resume;	/* auto resume, stopped by resume_abort */
+	GThread *thread;	/* running the job, set once started */
+	volatile int state;	/* _recorder_async_job_state_e */
+} _recorder_async_job_s;
+
+static void __async_job_free(_recorder_async_job_s *job){
+	g_free(job->path);
+	g_free(job);
+}
+
+/* the commit is over, setters flush again */
+static void __async_job_cancelled(recorder_s *handle, _recorder_async_job_s *job){
+	if( job->commit )
+		g_atomic_int_set(&handle->commit_pending, 0);
+}
+
+static void __async_job_run(void *data){
+	_recorder_async_job_s *job = (_recorder_async_job_s*)data;
+	recorder_s *handle = job->handle;
+	int ret;
+
+	/* cancelled jobs must not touch the handle, it may be destroyed already */
+	if( !g_atomic_int_compare_and_exchange(&job->state, _RECORDER_ASYNC_JOB_PENDING, _RECORDER_ASYNC_JOB_STARTED) ){
+		__async_job_free(job);
+		return;
+	}
+
+	job->thread = g_thread_self();
+	ret = job->func((recorder_h)handle);
+
+	/* the handle may be destroyed as soon as the slot is free, the outcome of a resume is taken before */
+	if( job->resume && handle->resume_report ){
+		job->resumed_callback = (recorder_auto_resumed_cb)handle->user_cb[_RECORDER_EVENT_TYPE_AUTO_RESUMED];
+		job->user_data = handle->user_data[_RECORDER_EVENT_TYPE_AUTO_RESUMED];
+		job->path = handle->resume_filename;
+		job->gap = handle->resume_gap;
+		handle->resume_filename = NULL;
+		handle->resume_report = false;
+	}
+
+	g_mutex_lock(&handle->async_lock);
+	if( job->commit )
+		g_atomic_int_set(&handle->commit_pending, 0);
+	handle->async_job = NULL;
+	g_cond_broadcast(&handle->async_cond);
+	g_mutex_unlock(&handle->async_lock);
+
+	// callbacks run with the slot free, they may start the next operation on the handle
+	if( job->resumed_callback ){
+		job->resumed_callback(ret, job->path, job->gap, job->user_data);
+	}else if( job->commit_callback ){
+		struct stat st;
+		unsigned long long size = 0;
+		if( ret == RECORDER_ERROR_NONE && job->path && stat(job->path, &st) == 0 )
+			size = st.st_size;
+		job->commit_callback(ret, job->path, size, job->user_data);
+	}else if( job->callback ){
+		job->callback(ret, job->user_data);
+	}
+	__async_job_free(job);
+}
+
+static _recorder_async_job_s *__async_job_new(recorder_s *handle, int (*func)(recorder_h), void *user_data){
+	_recorder_async_job_s *job = g_new0(_recorder_async_job_s, 1);
+	job->handle = handle;
+	job->func = func;
+	job->user_data = user_data;
+	job->state = _RECORDER_ASYNC_JOB_PENDING;
+	return job;
+}
+
+/* takes the ownership of job */
+static int __async_start(recorder_s *handle, _recorder_async_job_s *job, const char *caller){
+	int ret;
+
+	g_mutex_lock(&handle->async_lock);
+	if( handle->async_job && handle->async_job->realize ){
+		// a queued speculative realize is dropped, a running one is waited for
+		if( g_atomic_int_compare_and_exchange(&handle->async_job->state, _RECORDER_ASYNC_JOB_PENDING, _RECORDER_ASYNC_JOB_CANCELLED) )
+			handle->async_job = NULL;
+		while( handle->async_job && handle->async_job->realize )
+			g_cond_wait(&handle->async_cond, &handle->async_lock);
+	}
+	if( handle->async_job ){
+		g_mutex_unlock(&handle->async_lock);
+		__async_job_free(job);
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : another job is in progress", caller, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+	if( job->commit )
+		g_atomic_int_set(&handle->commit_pending, 1);
+	handle->async_job = job;
+	g_mutex_unlock(&handle->async_lock);
+
+	ret = _recorder_worker_run(__async_job_run, job);
+	if( ret != RECORDER_ERROR_NONE ){
+		g_mutex_lock(&handle->async_lock);
+		__async_job_cancelled(handle, job);
+		handle->async_job = NULL;
+		g_mutex_unlock(&handle->async_lock);
+		__async_job_free(job);
+	}
+
+	return ret;
+}
+
+void _recorder_async_init(recorder_s *handle){
+	g_mutex_init(&handle->async_lock);
+	g_cond_init(&handle->async_cond);
+	handle->async_job = NULL;
+	handle->commit_pending = 0;
+}
+
+void _recorder_async_flush(recorder_s *handle){
+	g_atomic_int_set(&handle->resume_abort, 1);
+	g_mutex_lock(&handle->async_lock);
+	if( handle->async_job &&
+		g_atomic_int_compare_and_exchange(&handle->async_job->state, _RECORDER_ASYNC_JOB_PENDING, _RECORDER_ASYNC_JOB_CANCELLED) ){
+		__async_job_cancelled(handle, handle->async_job);
+		handle->async_job = NULL;
+	}
+	while( handle->async_job )
+		g_cond_wait(&handle->async_cond, &handle->async_lock);
+	g_mutex_unlock(&handle->async_lock);
+}
+
+void _recorder_async_wait(recorder_s *handle){
+	g_mutex_lock(&handle->async_lock);
+	while( handle->async_job )
+		g_cond_wait(&handle->async_cond, &handle->async_lock);
+	g_mutex_unlock(&handle->async_lock);
+}
+
+/*
+ * a realize still queued is taken back, the caller realizes inline.
+ * The caller may be a worker itself, it must never wait for a job queued behind it.
+ */
+void _recorder_async_wait_realize(recorder_s *handle){
+	g_mutex_lock(&handle->async_lock);
+	if( handle->async_job && handle->async_job->realize &&
+		g_atomic_int_compare_and_exchange(&handle->async_job->state, _RECORDER_ASYNC_JOB_PENDING, _RECORDER_ASYNC_JOB_CANCELLED) )
+		handle->async_job = NULL;
+	while( handle->async_job && handle->async_job->realize )
+		g_cond_wait(&handle->async_cond, &handle->async_lock);
+	g_mutex_unlock(&handle->async_lock);
+}
+
+int _recorder_async_run(recorder_s *handle, int (*func)(recorder_h recorder)){
+	return __async_start(handle, __async_job_new(handle, func, NULL), __func__);
+}
+
+int _recorder_async_resume(recorder_s *handle, int (*func)(recorder_h recorder)){
+	_recorder_async_job_s *job = __async_job_new(handle, func, NULL);
+	job->resume = true;
+	g_atomic_int_set(&handle->resume_abort, 0);
+	return __async_start(handle, job, __func__);
+}
+
+void _recorder_async_abort_resume(recorder_s *handle){
+	g_mutex_lock(&handle->async_lock);
+	// the resume drives the handle through the same API
+	if( handle->async_job && handle->async_job->resume && handle->async_job->thread != g_thread_self() ){
+		g_atomic_int_set(&handle->resume_abort, 1);
+		if( g_atomic_int_compare_and_exchange(&handle->async_job->state, _RECORDER_ASYNC_JOB_PENDING, _RECORDER_ASYNC_JOB_CANCELLED) )
+			handle->async_job = NULL;
+		while( handle->async_job && handle->async_job->resume )
+			g_cond_wait(&handle->async_cond, &handle->async_lock);
+	}
+	g_mutex_unlock(&handle->async_lock);
+}
+
+/*
+ * Speculative realize
+ * The pipeline of a new audio recorder is realized on the worker, recorder_prepare() only waits for the rest.
+ * A realize the worker has not picked up yet is done by recorder_prepare() itself.
+ */
+static volatile int __speculative_realize = 0;
+
+int recorder_set_speculative_realize(bool enable){
+	g_atomic_int_set(&__speculative_realize, enable ? 1 : 0);
+	return RECORDER_ERROR_NONE;
+}
+
+static int __async_realize(recorder_h recorder){
+	return mm_camcorder_realize(((recorder_s*)recorder)->mm_handle);
+}
+
+void _recorder_async_realize(recorder_s *handle){
+	_recorder_async_job_s *job;
+
+	if( !g_atomic_int_get(&__speculative_realize) )
+		return;
+
+	job = __async_job_new(handle, __async_realize, NULL);
+	job->realize = true;
+	handle->speculative = true;
+	handle->speculative_stale = false;
+	if( __async_start(handle, job, __func__) != RECORDER_ERROR_NONE )
+		handle->speculative = false;
+}
+
+int recorder_prepare_async(recorder_h recorder, recorder_async_completed_cb callback, void *user_data){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	_recorder_async_job_s *job = __async_job_new((recorder_s*)recorder, recorder_prepare, user_data);
+	job->callback = callback;
+	return __async_start((recorder_s*)recorder, job, __func__);
+}
+
+int recorder_unprepare_async(recorder_h recorder, recorder_async_completed_cb callback, void *user_data){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	_recorder_async_job_s *job = __async_job_new((recorder_s*)recorder, recorder_unprepare, user_data);
+	job->callback = callback;
+	return __async_start((recorder_s*)recorder, job, __func__);
+}
+
+int recorder_commit_async(recorder_h recorder, recorder_commit_completed_cb callback, void *user_data){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	_recorder_async_job_s *job = __async_job_new((recorder_s*)recorder, recorder_commit, user_data);
+	char *path = NULL;
+
+	/* the target is read now, the next take may change it before the commit is over */
+	job->path = _recorder_writer_get_path((recorder_s*)recorder);
+	if( job->path == NULL && recorder_get_filename(recorder, &path) == RECORDER_ERROR_NONE && path ){
+		job->path = g_strdup(path);
+		free(path);
+	}
+	job->commit = true;
+	job->commit_callback = callback;
+	return __async_start((recorder_s*)recorder, job, __func__);
+}
+
+int recorder_cancel_async(recorder_h recorder){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+	int ret = RECORDER_ERROR_INVALID_STATE;
+
+	g_mutex_lock(&handle->async_lock);
+	if( handle->async_job &&
+		g_atomic_int_compare_and_exchange(&handle->async_job->state, _RECORDER_ASYNC_JOB_PENDING, _RECORDER_ASYNC_JOB_CANCELLED) ){
+		__async_job_cancelled(handle, handle->async_job);
+		handle->async_job = NULL;
+		ret = RECORDER_ERROR_NONE;
+	}
+	g_mutex_unlock(&handle->async_lock);
+
+	if( ret != RECORDER_ERROR_NONE )
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : no job to cancel or the job is running", __func__, RECORDER_ERROR_INVALID_STATE);
+	return ret;
+}
@@ -0,0 +1,222 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <glib.h>
+#include <mm.h>
+#include <mm_camcorder.h>
+#include <mm_types.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+#define RECORDER_CAPABILITY_CACHE_MAGIC		0x50414352	/* "RCAP" */
+#define RECORDER_CAPABILITY_CACHE_VERSION	2
+
+/*
+ * Audio capabilities only depend on the core library, so they are queried once per process
+ * and shared by every audio handle. Once a capability is marked as loaded its values are never modified again.
+ * Video capabilities depend on the camera device, which neither the camera handle nor the core attributes expose,
+ * so they are kept in the handle bound to the device.
+ */
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t lib_size;
+	int64_t lib_mtime;
+	uint64_t lib_ino;
+	uint32_t loaded;
+	uint32_t table_size;
+} _recorder_capability_cache_header_s;
+
+static const char *__capability_attr_name[_RECORDER_CAPABILITY_NUM] = {
+	MMCAM_FILE_FORMAT,	//_RECORDER_CAPABILITY_FILE_FORMAT
+	MMCAM_AUDIO_ENCODER,	//_RECORDER_CAPABILITY_AUDIO_ENCODER
+	MMCAM_VIDEO_ENCODER	//_RECORDER_CAPABILITY_VIDEO_ENCODER
+};
+
+G_LOCK_DEFINE_STATIC(capability);
+static unsigned int __capability_loaded;	/* bit mask of _recorder_capability_e */
+static _recorder_capability_values_s __capability_table[_RECORDER_CAPABILITY_NUM];
+static char *__capability_cache_path;
+
+static int __capability_lib_identity(_recorder_capability_cache_header_s *header){
+	Dl_info info;
+	struct stat st;
+
+	if( dladdr((void*)mm_camcorder_create, &info) == 0 || info.dli_fname == NULL )
+		return -1;
+	if( stat(info.dli_fname, &st) != 0 )
+		return -1;
+
+	header->lib_size = st.st_size;
+	header->lib_mtime = st.st_mtime;
+	header->lib_ino = st.st_ino;
+	return 0;
+}
+
+/* should be called with capability lock */
+static void __capability_cache_read(void){
+	_recorder_capability_cache_header_s expected;
+	_recorder_capability_cache_header_s header;
+	FILE *fp;
+
+	if( __capability_lib_identity(&expected) != 0 )
+		return;
+
+	fp = fopen(__capability_cache_path, "rb");
+	if( fp == NULL )
+		return;
+
+	if( fread(&header, sizeof(header), 1, fp) == 1 &&
+		header.magic == RECORDER_CAPABILITY_CACHE_MAGIC &&
+		header.version == RECORDER_CAPABILITY_CACHE_VERSION &&
+		header.table_size == sizeof(__capability_table) &&
+		header.lib_size == expected.lib_size &&
+		header.lib_mtime == expected.lib_mtime &&
+		header.lib_ino == expected.lib_ino ){
+		_recorder_capability_values_s table[_RECORDER_CAPABILITY_NUM];
+		if( fread(table, sizeof(table), 1, fp) == 1 ){
+			int i;
+			for( i = 0 ; i < _RECORDER_CAPABILITY_NUM ; i++ ){
+				if( !(header.loaded & (1 << i)) || (__capability_loaded & (1 << i)) )
+					continue;
+				if( table[i].count < 0 || table[i].count > _RECORDER_CAPABILITY_MAX_VALUES )
+					continue;
+				__capability_table[i] = table[i];
+				__capability_loaded |= (1 << i);
+			}
+		}
+	}else{
+		LOGI("[%s] capability cache %s is stale", __func__, __capability_cache_path);
+	}
+	fclose(fp);
+}
+
+/* should be called with capability lock */
+static void __capability_cache_write(void){
+	_recorder_capability_cache_header_s header;
+	char *tmp_path;
+	FILE *fp;
+	int written;
+
+	memset(&header, 0, sizeof(header));
+	if( __capability_lib_identity(&header) != 0 )
+		return;
+	header.magic = RECORDER_CAPABILITY_CACHE_MAGIC;
+	header.version = RECORDER_CAPABILITY_CACHE_VERSION;
+	header.loaded = __capability_loaded;
+	header.table_size = sizeof(__capability_table);
+
+	tmp_path = g_strdup_printf("%s.%d", __capability_cache_path, getpid());
+	fp = fopen(tmp_path, "wb");
+	if( fp == NULL ){
+		LOGW("[%s] can not write capability cache %s", __func__, tmp_path);
+		g_free(tmp_path);
+		return;
+	}
+	written = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+		fwrite(__capability_table, sizeof(__capability_table), 1, fp) == 1;
+	if( fclose(fp) != 0 )
+		written = 0;
+
+	// rename is atomic, readers see either the old or the new cache
+	if( !written || rename(tmp_path, __capability_cache_path) != 0 ){
+		LOGW("[%s] can not write capability cache %s", __func__, __capability_cache_path);
+		unlink(tmp_path);
+	}
+	g_free(tmp_path);
+}
+
+static int __capability_query(recorder_s *handle, _recorder_capability_e capability, _recorder_capability_values_s *entry){
+	MMCamAttrsInfo info;
+	int ret;
+	int i;
+
+	ret = mm_camcorder_get_attribute_info(handle->mm_handle, __capability_attr_name[capability], &info);
+	if( ret != MM_ERROR_NONE )
+		return ret;
+
+	entry->count = 0;
+	for( i = 0 ; i < info.int_array.count && entry->count < _RECORDER_CAPABILITY_MAX_VALUES ; i++ )
+		entry->values[entry->count++] = info.int_array.array[i];
+	if( info.int_array.count > _RECORDER_CAPABILITY_MAX_VALUES )
+		LOGW("[%s] [%s] has %d values, only the first %d are kept", __func__, __capability_attr_name[capability], info.int_array.count, _RECORDER_CAPABILITY_MAX_VALUES);
+
+	return MM_ERROR_NONE;
+}
+
+int _recorder_capability_get(recorder_s *handle, _recorder_capability_e capability, const int **values, int *count){
+	g_return_val_if_fail(handle != NULL && values != NULL && count != NULL, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	g_return_val_if_fail(capability >= 0 && capability < _RECORDER_CAPABILITY_NUM, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	unsigned int bit = 1 << capability;
+	_recorder_capability_values_s *entry;
+	int ret = MM_ERROR_NONE;
+
+	if( handle->type == _RECORDER_TYPE_VIDEO ){
+		entry = &handle->device_capability[capability];
+		if( !(handle->device_capability_loaded & bit) ){
+			ret = __capability_query(handle, capability, entry);
+			if( ret == MM_ERROR_NONE )
+				handle->device_capability_loaded |= bit;
+		}
+	}else{
+		entry = &__capability_table[capability];
+		G_LOCK(capability);
+		if( !(__capability_loaded & bit) ){
+			ret = __capability_query(handle, capability, entry);
+			if( ret == MM_ERROR_NONE ){
+				__capability_loaded |= bit;
+				if( __capability_cache_path )
+					__capability_cache_write();
+			}
+		}
+		G_UNLOCK(capability);
+	}
+
+	if( ret == MM_ERROR_NONE ){
+		*values = entry->values;
+		*count = entry->count;
+	}
+	return ret;
+}
+
+int recorder_set_capability_cache_path(const char *path){
+	G_LOCK(capability);
+	g_free(__capability_cache_path);
+	__capability_cache_path = g_strdup(path);
+	if( __capability_cache_path )
+		__capability_cache_read();
+	G_UNLOCK(capability);
+
+	return RECORDER_ERROR_NONE;
+}
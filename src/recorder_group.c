@@ -0,0 +1,368 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Group of audio recorders
+ * A group operation is fanned out to a thread pool owned by the group and returns when all members are done,
+ * so N recorders cost the slowest member instead of the sum of all of them, up to the size of the pool.
+ * The shared worker is not used : it has only a few threads, and a member operation may wait for a job queued on it.
+ */
+
+/* threads of a group besides the calling one, members beyond it wait for a free thread */
+#define RECORDER_GROUP_MAX_THREADS	8
+
+typedef struct recorder_group_s *recorder_group_p;
+typedef int (*__group_member_func)(recorder_group_p group, int index);
+
+typedef struct {
+	recorder_group_p group;
+	int index;
+} __group_task_s;
+
+typedef struct recorder_group_s {
+	GMutex op_lock;		/* serializes group operations */
+	GMutex lock;		/* protects the fields below */
+	GCond done;		/* signalled when the last pooled member of an operation is done */
+	GThreadPool *pool;	/* NULL for a single recorder */
+	int pending;		/* pooled members of the running operation not done yet */
+	int count;
+	recorder_h *members;
+	int *result;		/* result of the last operation per member */
+	int *elapsed_time;	/* last recording status per member */
+	int *file_size;
+	__group_member_func func;
+	int (*op)(recorder_h recorder);
+	recorder_profile_h profile;
+	__group_task_s *status;	/* user data of the recording status callback of each member */
+	int failed_count;
+	int last_operation_time;
+} recorder_group_s;
+
+static void __group_recording_status_cb(int elapsed_time, int file_size, void *user_data){
+	__group_task_s *member = (__group_task_s*)user_data;
+	recorder_group_s *group = member->group;
+
+	g_mutex_lock(&group->lock);
+	group->elapsed_time[member->index] = elapsed_time;
+	group->file_size[member->index] = file_size;
+	g_mutex_unlock(&group->lock);
+}
+
+static void __group_task_run(__group_task_s *task){
+	int ret = task->group->func(task->group, task->index);
+
+	g_mutex_lock(&task->group->lock);
+	task->group->result[task->index] = ret;
+	g_mutex_unlock(&task->group->lock);
+}
+
+static void __group_task_thread(gpointer data, gpointer user_data){
+	__group_task_s *task = (__group_task_s*)data;
+	recorder_group_s *group = task->group;
+
+	__group_task_run(task);
+	g_mutex_lock(&group->lock);
+	if( --group->pending == 0 )
+		g_cond_signal(&group->done);
+	g_mutex_unlock(&group->lock);
+}
+
+/* runs func on every member in parallel, the first member on the calling thread, group->op_lock must be held */
+static int __group_run(recorder_group_s *group, __group_member_func func, const char *caller){
+	__group_task_s *tasks = g_new0(__group_task_s, group->count);
+	gint64 begin = g_get_monotonic_time();
+	GError *error = NULL;
+	int ret = RECORDER_ERROR_NONE;
+	int failed = 0;
+	int i;
+
+	group->func = func;
+	for( i = 0 ; i < group->count ; i++ ){
+		tasks[i].group = group;
+		tasks[i].index = i;
+	}
+	g_mutex_lock(&group->lock);
+	group->pending = group->count - 1;
+	g_mutex_unlock(&group->lock);
+	for( i = 1 ; i < group->count ; i++ ){
+		if( g_thread_pool_push(group->pool, &tasks[i], &error) )
+			continue;
+		// a member that can not be queued is run here instead of being skipped
+		LOGW("[%s] task push fail : %s", caller, error ? error->message : "unknown");
+		if( error ){
+			g_error_free(error);
+			error = NULL;
+		}
+		__group_task_thread(&tasks[i], NULL);
+	}
+	__group_task_run(&tasks[0]);
+
+	g_mutex_lock(&group->lock);
+	while( group->pending > 0 )
+		g_cond_wait(&group->done, &group->lock);
+	for( i = 0 ; i < group->count ; i++ ){
+		if( group->result[i] != RECORDER_ERROR_NONE ){
+			if( failed == 0 )
+				ret = group->result[i];
+			failed++;
+		}
+	}
+	group->failed_count = failed;
+	group->last_operation_time = (int)((g_get_monotonic_time() - begin) / G_TIME_SPAN_MILLISECOND);
+	g_mutex_unlock(&group->lock);
+
+	g_free(tasks);
+	if( failed > 0 )
+		LOGE("[%s] %d of %d recorders failed, first error(0x%08x)", caller, failed, group->count, ret);
+	return ret;
+}
+
+static int __group_member_op(recorder_group_s *group, int index){
+	return group->op(group->members[index]);
+}
+
+static int __group_run_op(recorder_group_s *group, int (*op)(recorder_h), const char *caller){
+	int ret;
+
+	g_mutex_lock(&group->op_lock);
+	group->op = op;
+	ret = __group_run(group, __group_member_op, caller);
+	g_mutex_unlock(&group->op_lock);
+
+	return ret;
+}
+
+static int __group_member_create(recorder_group_s *group, int index){
+	recorder_h recorder;
+	int ret;
+
+	ret = recorder_create_audiorecorder(&recorder);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	if( group->profile )
+		ret = recorder_apply_profile(recorder, group->profile);
+	if( ret != RECORDER_ERROR_NONE ){
+		recorder_destroy(recorder);
+		return ret;
+	}
+	group->members[index] = recorder;
+	return RECORDER_ERROR_NONE;
+}
+
+static int __group_member_apply_profile(recorder_group_s *group, int index){
+	return recorder_apply_profile(group->members[index], group->profile);
+}
+
+static int __group_member_destroy(recorder_group_s *group, int index){
+	recorder_h recorder = group->members[index];
+	recorder_state_e state = RECORDER_STATE_NONE;
+
+	if( recorder == NULL )
+		return RECORDER_ERROR_NONE;
+	recorder_get_state(recorder, &state);
+	if( state == RECORDER_STATE_RECORDING || state == RECORDER_STATE_PAUSED )
+		recorder_cancel(recorder);
+	if( state != RECORDER_STATE_CREATED )
+		recorder_unprepare(recorder);
+	group->members[index] = NULL;
+	((recorder_s*)recorder)->group_status_cb = NULL;
+	((recorder_s*)recorder)->group_status_data = NULL;
+	return recorder_destroy(recorder);
+}
+
+static void __group_free(recorder_group_s *group){
+	if( group->pool )
+		g_thread_pool_free(group->pool, FALSE, TRUE);
+	if( group->profile )
+		recorder_profile_destroy(group->profile);
+	g_free(group->members);
+	g_free(group->result);
+	g_free(group->elapsed_time);
+	g_free(group->file_size);
+	g_free(group->status);
+	g_cond_clear(&group->done);
+	g_mutex_clear(&group->lock);
+	g_mutex_clear(&group->op_lock);
+	g_free(group);
+}
+
+int recorder_group_create(int count, recorder_profile_h profile, recorder_group_h *group){
+	if( count <= 0 || group == NULL ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x)", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+
+	recorder_group_s *new_group = g_new0(recorder_group_s, 1);
+	GError *error = NULL;
+	int ret;
+
+	g_mutex_init(&new_group->op_lock);
+	g_mutex_init(&new_group->lock);
+	g_cond_init(&new_group->done);
+	if( count > 1 ){
+		new_group->pool = g_thread_pool_new(__group_task_thread, NULL, MIN(count - 1, RECORDER_GROUP_MAX_THREADS), FALSE, &error);
+		if( new_group->pool == NULL ){
+			LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : pool creation fail : %s", __func__, RECORDER_ERROR_INVALID_OPERATION, error ? error->message : "unknown");
+			if( error )
+				g_error_free(error);
+			g_cond_clear(&new_group->done);
+			g_mutex_clear(&new_group->lock);
+			g_mutex_clear(&new_group->op_lock);
+			g_free(new_group);
+			return RECORDER_ERROR_INVALID_OPERATION;
+		}
+	}
+	new_group->count = count;
+	new_group->members = g_new0(recorder_h, count);
+	new_group->result = g_new0(int, count);
+	new_group->elapsed_time = g_new0(int, count);
+	new_group->file_size = g_new0(int, count);
+	if( profile )
+		new_group->profile = _recorder_profile_ref(profile);
+
+	g_mutex_lock(&new_group->op_lock);
+	ret = __group_run(new_group, __group_member_create, __func__);
+	if( ret != RECORDER_ERROR_NONE )
+		__group_run(new_group, __group_member_destroy, __func__);
+	g_mutex_unlock(&new_group->op_lock);
+
+	if( ret != RECORDER_ERROR_NONE ){
+		__group_free(new_group);
+		return ret;
+	}
+
+	/* the statistics are collected next to the recording status callback of the application, which stays free */
+	__group_task_s *status = g_new0(__group_task_s, count);
+	int i;
+	for( i = 0 ; i < count ; i++ ){
+		status[i].group = new_group;
+		status[i].index = i;
+		((recorder_s*)new_group->members[i])->group_status_data = &status[i];
+		((recorder_s*)new_group->members[i])->group_status_cb = __group_recording_status_cb;
+	}
+	new_group->status = status;
+
+	*group = new_group;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_group_destroy(recorder_group_h group){
+	if( group == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	int ret;
+
+	g_mutex_lock(&group->op_lock);
+	ret = __group_run(group, __group_member_destroy, __func__);
+	g_mutex_unlock(&group->op_lock);
+
+	__group_free(group);
+	return ret;
+}
+
+int recorder_group_get_count(recorder_group_h group, int *count){
+	if( group == NULL || count == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	*count = group->count;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_group_get_recorder(recorder_group_h group, int index, recorder_h *recorder){
+	if( group == NULL || recorder == NULL || index < 0 || index >= group->count ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x)", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+	*recorder = group->members[index];
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_group_apply_profile(recorder_group_h group, recorder_profile_h profile){
+	if( group == NULL || profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	int ret;
+
+	g_mutex_lock(&group->op_lock);
+	_recorder_profile_ref(profile);
+	if( group->profile )
+		recorder_profile_destroy(group->profile);
+	group->profile = profile;
+	ret = __group_run(group, __group_member_apply_profile, __func__);
+	g_mutex_unlock(&group->op_lock);
+
+	return ret;
+}
+
+int recorder_group_prepare(recorder_group_h group){
+	if( group == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	return __group_run_op(group, recorder_prepare, __func__);
+}
+
+int recorder_group_unprepare(recorder_group_h group){
+	if( group == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	return __group_run_op(group, recorder_unprepare, __func__);
+}
+
+int recorder_group_start(recorder_group_h group){
+	if( group == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	return __group_run_op(group, recorder_start, __func__);
+}
+
+int recorder_group_commit(recorder_group_h group){
+	if( group == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	return __group_run_op(group, recorder_commit, __func__);
+}
+
+int recorder_group_cancel(recorder_group_h group){
+	if( group == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	return __group_run_op(group, recorder_cancel, __func__);
+}
+
+int recorder_group_get_stats(recorder_group_h group, recorder_group_stats_s *stats){
+	if( group == NULL || stats == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_state_e state;
+	int i;
+
+	memset(stats, 0, sizeof(recorder_group_stats_s));
+	stats->recorder_count = group->count;
+	for( i = 0 ; i < group->count ; i++ ){
+		if( recorder_get_state(group->members[i], &state) == RECORDER_ERROR_NONE &&
+			(state == RECORDER_STATE_RECORDING || state == RECORDER_STATE_PAUSED) )
+			stats->recording_count++;
+	}
+
+	g_mutex_lock(&group->lock);
+	for( i = 0 ; i < group->count ; i++ ){
+		if( group->elapsed_time[i] > stats->max_elapsed_time )
+			stats->max_elapsed_time = group->elapsed_time[i];
+		stats->total_file_size += group->file_size[i];
+	}
+	stats->failed_count = group->failed_count;
+	stats->last_operation_time = group->last_operation_time;
+	g_mutex_unlock(&group->lock);
+
+	return RECORDER_ERROR_NONE;
+}
@@ -0,0 +1,232 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <glib.h>
+#include <mm_camcorder.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Idle release
+ * An audio recorder left in READY longer than its idle timeout is unrealized by the reaper thread.
+ * Attributes live in the core handle and survive, so the next recorder_start() only has to realize again.
+ * The handle is either in the reaper list, being released, released, being prepared again or none of them, all under __idle_lock.
+ * The recorder stays READY for the application through all of it, the state messages of the core are not reported.
+ */
+static GMutex __idle_lock;
+static GCond __idle_cond;
+static GList *__idle_list;	/* armed recorder_s, sorted by deadline */
+static GThread *__idle_thread;
+
+/*
+ * resident set size of the process in KB, the core does not report what a pipeline holds
+ * Sampled right around the unrealize, the difference is an estimate : other threads allocate and free meanwhile.
+ */
+static int __idle_resident_kb(void){
+	FILE *fp = fopen("/proc/self/statm", "r");
+	unsigned long size = 0, resident = 0;
+
+	if( fp == NULL )
+		return 0;
+	if( fscanf(fp, "%lu %lu", &size, &resident) != 2 )
+		resident = 0;
+	fclose(fp);
+	return (int)(resident * (sysconf(_SC_PAGESIZE) / 1024));
+}
+
+static gint __idle_compare(gconstpointer a, gconstpointer b){
+	const recorder_s *ha = (const recorder_s*)a;
+	const recorder_s *hb = (const recorder_s*)b;
+	return ha->idle_deadline < hb->idle_deadline ? -1 : (ha->idle_deadline > hb->idle_deadline ? 1 : 0);
+}
+
+static void __idle_release(recorder_s *handle){
+	MMCamcorderStateType mmstate;
+	int before = 0;
+	int released;
+	int ret;
+
+	mm_camcorder_get_state(handle->mm_handle, &mmstate);
+	if( mmstate != MM_CAMCORDER_STATE_PREPARE )
+		return;
+
+	ret = mm_camcorder_stop(handle->mm_handle);
+	if( ret == MM_ERROR_NONE ){
+		before = __idle_resident_kb();
+		ret = mm_camcorder_unrealize(handle->mm_handle);
+	}
+	if( ret != MM_ERROR_NONE ){
+		LOGE("[%s] release fail(0x%08x)", __func__, ret);
+		return;
+	}
+	released = before - __idle_resident_kb();
+
+	handle->idle_released = true;
+	handle->idle_stats.release_count++;
+	// an allocation of another thread may outgrow what the pipeline gave back
+	handle->idle_stats.released_memory = released > 0 ? released : 0;
+	LOGI("[%s] idle recorder released, about %d KB", __func__, handle->idle_stats.released_memory);
+}
+
+static gpointer __idle_thread_func(gpointer data){
+	recorder_s *handle;
+	gint64 now;
+
+	g_mutex_lock(&__idle_lock);
+	while( true ){
+		if( __idle_list == NULL ){
+			g_cond_wait(&__idle_cond, &__idle_lock);
+			continue;
+		}
+		handle = (recorder_s*)__idle_list->data;
+		now = g_get_monotonic_time();
+		if( handle->idle_deadline > now ){
+			g_cond_wait_until(&__idle_cond, &__idle_lock, handle->idle_deadline);
+			continue;
+		}
+
+		__idle_list = g_list_delete_link(__idle_list, __idle_list);
+		handle->idle_releasing = true;
+		g_mutex_unlock(&__idle_lock);
+
+		__idle_release(handle);
+
+		g_mutex_lock(&__idle_lock);
+		handle->idle_releasing = false;
+		g_cond_broadcast(&__idle_cond);
+	}
+
+	return NULL;
+}
+
+void _recorder_idle_arm(recorder_s *handle){
+	if( handle->type != _RECORDER_TYPE_AUDIO )
+		return;
+
+	g_mutex_lock(&__idle_lock);
+	__idle_list = g_list_remove(__idle_list, handle);
+	if( handle->idle_timeout > 0 ){
+		if( __idle_thread == NULL )
+			__idle_thread = g_thread_new("recorder-idle", __idle_thread_func, NULL);
+		handle->idle_deadline = g_get_monotonic_time() + (gint64)handle->idle_timeout * G_TIME_SPAN_MILLISECOND;
+		__idle_list = g_list_insert_sorted(__idle_list, handle, __idle_compare);
+		g_cond_broadcast(&__idle_cond);
+	}
+	g_mutex_unlock(&__idle_lock);
+}
+
+bool _recorder_idle_disarm(recorder_s *handle){
+	bool released;
+
+	g_mutex_lock(&__idle_lock);
+	__idle_list = g_list_remove(__idle_list, handle);
+	while( handle->idle_releasing )
+		g_cond_wait(&__idle_cond, &__idle_lock);
+	released = handle->idle_released;
+	handle->idle_released = false;
+	g_mutex_unlock(&__idle_lock);
+
+	return released;
+}
+
+bool _recorder_idle_reacquire_begin(recorder_s *handle){
+	bool released;
+
+	g_mutex_lock(&__idle_lock);
+	__idle_list = g_list_remove(__idle_list, handle);
+	while( handle->idle_releasing )
+		g_cond_wait(&__idle_cond, &__idle_lock);
+	released = handle->idle_released;
+	handle->idle_released = false;
+	handle->idle_reacquiring = released;
+	g_mutex_unlock(&__idle_lock);
+
+	return released;
+}
+
+void _recorder_idle_reacquire_end(recorder_s *handle, bool prepared, int elapsed){
+	g_mutex_lock(&__idle_lock);
+	handle->idle_reacquiring = false;
+	if( prepared ){
+		handle->idle_stats.reacquire_count++;
+		handle->idle_stats.last_reacquire_time = elapsed;
+		handle->idle_stats.total_reacquire_time += elapsed;
+	}
+	g_mutex_unlock(&__idle_lock);
+}
+
+bool _recorder_idle_is_released(recorder_s *handle){
+	bool released;
+
+	g_mutex_lock(&__idle_lock);
+	released = handle->idle_released || handle->idle_releasing || handle->idle_reacquiring;
+	g_mutex_unlock(&__idle_lock);
+
+	return released;
+}
+
+int recorder_set_idle_release_timeout(recorder_h recorder, int timeout){
+	if( recorder == NULL || timeout < 0 ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x)", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+	recorder_s *handle = (recorder_s*)recorder;
+	MMCamcorderStateType mmstate;
+
+	if( handle->type != _RECORDER_TYPE_AUDIO ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : video recorder pipeline is owned by the camera", __func__, RECORDER_ERROR_INVALID_OPERATION);
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+
+	g_mutex_lock(&__idle_lock);
+	handle->idle_timeout = timeout;
+	g_mutex_unlock(&__idle_lock);
+
+	// a recorder already idle starts counting from now
+	mm_camcorder_get_state(handle->mm_handle, &mmstate);
+	if( mmstate == MM_CAMCORDER_STATE_PREPARE )
+		_recorder_idle_arm(handle);
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_get_idle_release_timeout(recorder_h recorder, int *timeout){
+	if( recorder == NULL || timeout == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	*timeout = ((recorder_s*)recorder)->idle_timeout;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_get_idle_release_stats(recorder_h recorder, recorder_idle_stats_s *stats){
+	if( recorder == NULL || stats == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+
+	g_mutex_lock(&__idle_lock);
+	*stats = handle->idle_stats;
+	g_mutex_unlock(&__idle_lock);
+
+	return RECORDER_ERROR_NONE;
+}
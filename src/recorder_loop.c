@@ -0,0 +1,260 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Loop recording
+ * The time limit closes each segment, the limit message queues the switch to the next segment with recorder_split(),
+ * and segments older than the window are deleted by the same job. The loop lock keeps the window stable while it is saved.
+ */
+typedef struct _recorder_loop_s {
+	GMutex lock;
+	int duration;		/* seconds per segment */
+	int count;		/* segments kept, including the one being recorded */
+	char *prefix;
+	unsigned int sequence;
+	GQueue segments;	/* char*, oldest first, the last one is being recorded */
+} _recorder_loop_s;
+
+static const char *__loop_extension(recorder_s *handle){
+	recorder_file_format_e format = RECORDER_FILE_FORMAT_3GP;
+
+	recorder_get_file_format((recorder_h)handle, &format);
+	switch( format ){
+		case RECORDER_FILE_FORMAT_MP4:
+			return ".mp4";
+		case RECORDER_FILE_FORMAT_AMR:
+			return ".amr";
+		case RECORDER_FILE_FORMAT_ADTS:
+			return ".aac";
+		case RECORDER_FILE_FORMAT_WAV:
+			return ".wav";
+		default:
+			return ".3gp";
+	}
+}
+
+/* loop->lock must be held */
+static char *__loop_next_segment(recorder_s *handle, _recorder_loop_s *loop){
+	return g_strdup_printf("%s_%06u%s", loop->prefix, loop->sequence++, __loop_extension(handle));
+}
+
+/* loop->lock must be held */
+static void __loop_trim(_recorder_loop_s *loop){
+	char *oldest;
+
+	while( (int)g_queue_get_length(&loop->segments) > loop->count ){
+		oldest = g_queue_pop_head(&loop->segments);
+		if( unlink(oldest) != 0 && errno != ENOENT )
+			LOGW("[%s] can not delete [%s]", __func__, oldest);
+		g_free(oldest);
+	}
+}
+
+/* loop->lock must be held */
+static int __loop_rotate(recorder_s *handle, _recorder_loop_s *loop){
+	char *next = __loop_next_segment(handle, loop);
+	int ret;
+
+	ret = recorder_split((recorder_h)handle, next);
+	if( ret != RECORDER_ERROR_NONE ){
+		g_free(next);
+		return ret;
+	}
+	g_queue_push_tail(&loop->segments, next);
+	__loop_trim(loop);
+
+	return RECORDER_ERROR_NONE;
+}
+
+static int __loop_rotate_job(recorder_h recorder){
+	recorder_s *handle = (recorder_s*)recorder;
+	_recorder_loop_s *loop = handle->loop;
+	int ret;
+
+	if( loop == NULL )
+		return RECORDER_ERROR_NONE;
+
+	g_mutex_lock(&loop->lock);
+	ret = __loop_rotate(handle, loop);
+	g_mutex_unlock(&loop->lock);
+
+	if( ret != RECORDER_ERROR_NONE )
+		LOGE("[%s] segment rotation fail(0x%08x)", __func__, ret);
+	return ret;
+}
+
+char *_recorder_loop_first_segment(recorder_s *handle){
+	_recorder_loop_s *loop = handle->loop;
+	char *first;
+
+	if( loop == NULL )
+		return NULL;
+
+	g_mutex_lock(&loop->lock);
+	first = __loop_next_segment(handle, loop);
+	g_queue_push_tail(&loop->segments, g_strdup(first));
+	__loop_trim(loop);
+	g_mutex_unlock(&loop->lock);
+
+	return first;
+}
+
+bool _recorder_loop_limit_reached(recorder_s *handle){
+	if( handle->loop == NULL )
+		return false;
+
+	// the core message thread must not wait for the commit of the segment
+	if( _recorder_async_run(handle, __loop_rotate_job) != RECORDER_ERROR_NONE ){
+		LOGE("[%s] segment rotation can not be queued, recording stops at the limit", __func__);
+		return false;
+	}
+	return true;
+}
+
+static void __loop_free(_recorder_loop_s *loop){
+	char *segment;
+
+	while( (segment = g_queue_pop_head(&loop->segments)) != NULL )
+		g_free(segment);
+	g_free(loop->prefix);
+	g_mutex_clear(&loop->lock);
+	g_free(loop);
+}
+
+void _recorder_loop_destroy(recorder_s *handle){
+	if( handle->loop ){
+		__loop_free(handle->loop);
+		handle->loop = NULL;
+	}
+}
+
+int recorder_set_loop_recording(recorder_h recorder, int duration, int count, const char *prefix){
+	if( recorder == NULL || duration < 0 || (duration > 0 && (count < 2 || prefix == NULL)) ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x)", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_state_e state;
+	_recorder_loop_s *loop;
+	int ret;
+
+	recorder_get_state(recorder, &state);
+	if( state > RECORDER_STATE_READY ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x)", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+
+	ret = recorder_attr_set_time_limit(recorder, duration);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+
+	// a rotation queued by the last segment of the previous recording still uses the loop
+	_recorder_async_wait(handle);
+	_recorder_loop_destroy(handle);
+	if( duration == 0 )
+		return RECORDER_ERROR_NONE;
+
+	loop = g_new0(_recorder_loop_s, 1);
+	g_mutex_init(&loop->lock);
+	g_queue_init(&loop->segments);
+	loop->duration = duration;
+	loop->count = count;
+	loop->prefix = g_strdup(prefix);
+	handle->loop = loop;
+
+	return RECORDER_ERROR_NONE;
+}
+
+/* a segment saved by an earlier call is already linked, any other file of the same name is not the segment */
+static bool __loop_same_file(const char *a, const char *b){
+	struct stat sa, sb;
+
+	if( stat(a, &sa) != 0 || stat(b, &sb) != 0 )
+		return false;
+	return sa.st_dev == sb.st_dev && sa.st_ino == sb.st_ino;
+}
+
+int recorder_save_loop_recording(recorder_h recorder, const char *directory, int *count){
+	if( recorder == NULL || directory == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+	_recorder_loop_s *loop = handle->loop;
+	recorder_state_e state;
+	GList *item;
+	char *base, *path;
+	int saved = 0;
+	int error;
+	int ret = RECORDER_ERROR_NONE;
+
+	if( loop == NULL ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : loop recording is disabled", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+
+	g_mutex_lock(&loop->lock);
+
+	// closes the segment being recorded so that the window is complete on disk
+	recorder_get_state(recorder, &state);
+	if( state == RECORDER_STATE_RECORDING || state == RECORDER_STATE_PAUSED ){
+		ret = __loop_rotate(handle, loop);
+		if( ret != RECORDER_ERROR_NONE ){
+			g_mutex_unlock(&loop->lock);
+			return ret;
+		}
+	}
+
+	for( item = loop->segments.head ; item ; item = item->next ){
+		if( item->next == NULL && (state == RECORDER_STATE_RECORDING || state == RECORDER_STATE_PAUSED) )
+			break;
+		base = g_path_get_basename(item->data);
+		path = g_build_filename(directory, base, NULL);
+		error = link(item->data, path) == 0 ? 0 : errno;
+		if( error == 0 || (error == EEXIST && __loop_same_file(item->data, path)) ){
+			saved++;
+		}else if( error == EEXIST ){
+			LOGE("[%s] can not save [%s] : another file [%s] exists", __func__, (char*)item->data, path);
+			ret = RECORDER_ERROR_INVALID_OPERATION;
+		}else if( error != ENOENT ){
+			LOGE("[%s] can not save [%s] into [%s] : %s", __func__, (char*)item->data, directory, strerror(error));
+			ret = RECORDER_ERROR_INVALID_OPERATION;
+		}
+		g_free(path);
+		g_free(base);
+	}
+
+	g_mutex_unlock(&loop->lock);
+
+	if( count )
+		*count = saved;
+	return ret;
+}
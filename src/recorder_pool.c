@@ -0,0 +1,179 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Warm pool of audio recorders
+ * Recorders are created (and prepared if requested) on the library worker, so taking one is a queue pop.
+ * Every taken recorder is replaced in the background.
+ */
+typedef struct recorder_pool_s {
+	GMutex lock;
+	GCond cond;
+	GQueue ready;		/* recorder_h */
+	int size;
+	int pending;		/* refill jobs queued or running */
+	bool prepare;
+	bool destroying;
+	recorder_profile_h profile;
+} recorder_pool_s;
+
+static void __pool_release_recorder(recorder_pool_s *pool, recorder_h recorder){
+	if( pool->prepare )
+		recorder_unprepare(recorder);
+	recorder_destroy(recorder);
+}
+
+static int __pool_make_recorder(recorder_pool_s *pool, recorder_h *recorder){
+	recorder_h new_recorder;
+	int ret;
+
+	ret = recorder_create_audiorecorder(&new_recorder);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+
+	if( pool->profile )
+		ret = recorder_apply_profile(new_recorder, pool->profile);
+	if( ret == RECORDER_ERROR_NONE && pool->prepare )
+		ret = recorder_prepare(new_recorder);
+	if( ret != RECORDER_ERROR_NONE ){
+		recorder_destroy(new_recorder);
+		return ret;
+	}
+
+	*recorder = new_recorder;
+	return RECORDER_ERROR_NONE;
+}
+
+static void __pool_refill_job(void *data){
+	recorder_pool_s *pool = (recorder_pool_s*)data;
+	recorder_h recorder = NULL;
+	int ret;
+
+	ret = __pool_make_recorder(pool, &recorder);
+	if( ret != RECORDER_ERROR_NONE )
+		LOGE("[%s] refill fail(0x%08x)", __func__, ret);
+
+	g_mutex_lock(&pool->lock);
+	if( recorder && !pool->destroying && (int)g_queue_get_length(&pool->ready) < pool->size ){
+		g_queue_push_tail(&pool->ready, recorder);
+		recorder = NULL;
+	}
+	pool->pending--;
+	g_cond_broadcast(&pool->cond);
+	g_mutex_unlock(&pool->lock);
+
+	if( recorder )
+		__pool_release_recorder(pool, recorder);
+}
+
+/* pool->lock must be held */
+static void __pool_schedule_refill(recorder_pool_s *pool){
+	while( !pool->destroying && (int)g_queue_get_length(&pool->ready) + pool->pending < pool->size ){
+		pool->pending++;
+		if( _recorder_worker_run(__pool_refill_job, pool) != RECORDER_ERROR_NONE ){
+			pool->pending--;
+			break;
+		}
+	}
+}
+
+int recorder_pool_create(int size, recorder_profile_h profile, bool prepare, recorder_pool_h *pool){
+	if( size <= 0 || pool == NULL ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x)", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+
+	recorder_pool_s *new_pool = g_new0(recorder_pool_s, 1);
+	g_mutex_init(&new_pool->lock);
+	g_cond_init(&new_pool->cond);
+	g_queue_init(&new_pool->ready);
+	new_pool->size = size;
+	new_pool->prepare = prepare;
+	if( profile )
+		new_pool->profile = _recorder_profile_ref(profile);
+
+	g_mutex_lock(&new_pool->lock);
+	__pool_schedule_refill(new_pool);
+	g_mutex_unlock(&new_pool->lock);
+
+	*pool = new_pool;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_pool_destroy(recorder_pool_h pool){
+	if( pool == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_h recorder;
+
+	g_mutex_lock(&pool->lock);
+	pool->destroying = true;
+	while( pool->pending > 0 )
+		g_cond_wait(&pool->cond, &pool->lock);
+	g_mutex_unlock(&pool->lock);
+
+	while( (recorder = g_queue_pop_head(&pool->ready)) != NULL )
+		__pool_release_recorder(pool, recorder);
+
+	if( pool->profile )
+		recorder_profile_destroy(pool->profile);
+	g_cond_clear(&pool->cond);
+	g_mutex_clear(&pool->lock);
+	g_free(pool);
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_pool_acquire(recorder_pool_h pool, recorder_h *recorder){
+	if( pool == NULL || recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_h ready;
+
+	g_mutex_lock(&pool->lock);
+	ready = g_queue_pop_head(&pool->ready);
+	__pool_schedule_refill(pool);
+	g_mutex_unlock(&pool->lock);
+
+	if( ready ){
+		*recorder = ready;
+		return RECORDER_ERROR_NONE;
+	}
+
+	/* drained faster than refilled, fall back to a synchronous creation */
+	LOGW("[%s] pool is empty, create a recorder in place", __func__);
+	return __pool_make_recorder(pool, recorder);
+}
+
+int recorder_pool_get_available_count(recorder_pool_h pool, int *count){
+	if( pool == NULL || count == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+
+	g_mutex_lock(&pool->lock);
+	*count = g_queue_get_length(&pool->ready);
+	g_mutex_unlock(&pool->lock);
+
+	return RECORDER_ERROR_NONE;
+}
@@ -0,0 +1,130 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * File preallocation
+ * The core truncates the target when it opens it, so blocks are reserved right after recording starts,
+ * beyond the end of file (FALLOC_FL_KEEP_SIZE) where the muxer appends. The unused tail is released at the end of the take.
+ * The core may open the target only once its pipeline is running : the file is then created here, and the truncate of the core
+ * gives the reserved blocks back. The reservation is best effort, only the free space check is guaranteed.
+ */
+#define RECORDER_PREALLOC_OVERHEAD_PERCENT	5
+
+static long long __prealloc_estimate(recorder_s *handle){
+	int kbyte = 0, second = 0, audio_bitrate = 0, video_bitrate = 0;
+
+	recorder_attr_get_size_limit((recorder_h)handle, &kbyte);
+	if( kbyte > 0 )
+		return (long long)kbyte * 1024;
+
+	recorder_attr_get_time_limit((recorder_h)handle, &second);
+	if( second <= 0 )
+		return 0;
+	recorder_attr_get_audio_encoder_bitrate((recorder_h)handle, &audio_bitrate);
+	if( handle->type == _RECORDER_TYPE_VIDEO )
+		recorder_attr_get_video_encoder_bitrate((recorder_h)handle, &video_bitrate);
+
+	return ((long long)audio_bitrate + video_bitrate) / 8 * second * (100 + RECORDER_PREALLOC_OVERHEAD_PERCENT) / 100;
+}
+
+int _recorder_prealloc_begin(recorder_s *handle){
+	char *path = NULL;
+	long long size;
+	int fd;
+	int ret = RECORDER_ERROR_NONE;
+
+	if( !handle->prealloc )
+		return RECORDER_ERROR_NONE;
+	size = __prealloc_estimate(handle);
+	if( size <= 0 )
+		return RECORDER_ERROR_NONE;
+	if( recorder_get_filename((recorder_h)handle, &path) != RECORDER_ERROR_NONE || path == NULL )
+		return RECORDER_ERROR_NONE;
+	// descriptors given by the application are left alone
+	if( strncmp(path, "/proc/self/fd/", strlen("/proc/self/fd/")) == 0 ){
+		free(path);
+		return RECORDER_ERROR_NONE;
+	}
+
+	// not O_TRUNC, the core may already be writing the take
+	fd = open(path, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+	if( fd < 0 ){
+		LOGW("[%s] can not open [%s] : %s", __func__, path, strerror(errno));
+		free(path);
+		return RECORDER_ERROR_NONE;
+	}
+	if( fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, size) != 0 ){
+		if( errno == ENOSPC ){
+			LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : no space for %lld bytes", __func__, RECORDER_ERROR_INVALID_OPERATION, size);
+			ret = RECORDER_ERROR_INVALID_OPERATION;
+		}else{
+			LOGW("[%s] preallocation is not available : %s", __func__, strerror(errno));
+		}
+		close(fd);
+		free(path);
+		return ret;
+	}
+
+	_recorder_prealloc_end(handle);
+	handle->prealloc_fd = fd;
+	free(path);
+
+	return RECORDER_ERROR_NONE;
+}
+
+void _recorder_prealloc_end(recorder_s *handle){
+	struct stat st;
+
+	if( handle->prealloc_fd < 0 )
+		return;
+
+	// the size is the end of the muxed data, reserved blocks beyond it are released
+	if( fstat(handle->prealloc_fd, &st) == 0 && ftruncate(handle->prealloc_fd, st.st_size) != 0 )
+		LOGW("[%s] trim fail : %s", __func__, strerror(errno));
+	close(handle->prealloc_fd);
+	handle->prealloc_fd = -1;
+}
+
+int recorder_set_file_preallocation(recorder_h recorder, bool enable){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	((recorder_s*)recorder)->prealloc = enable;
+	return RECORDER_ERROR_NONE;
+}
+
+bool recorder_is_file_preallocation_enabled(recorder_h recorder){
+	if( recorder == NULL ) return false;
+	return ((recorder_s*)recorder)->prealloc;
+}
@@ -0,0 +1,653 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <glib.h>
+#include <mm_camcorder.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+#define RECORDER_PROFILE_MAGIC		0x46525052	/* "RPRF" */
+#define RECORDER_PROFILE_VERSION	1
+
+typedef enum {
+	_RECORDER_PROFILE_KEY_FILE_FORMAT = 0,
+	_RECORDER_PROFILE_KEY_AUDIO_ENCODER,
+	_RECORDER_PROFILE_KEY_VIDEO_ENCODER,
+	_RECORDER_PROFILE_KEY_AUDIO_SAMPLERATE,
+	_RECORDER_PROFILE_KEY_AUDIO_CHANNEL,
+	_RECORDER_PROFILE_KEY_AUDIO_ENCODER_BITRATE,
+	_RECORDER_PROFILE_KEY_VIDEO_ENCODER_BITRATE,
+	_RECORDER_PROFILE_KEY_SIZE_LIMIT,
+	_RECORDER_PROFILE_KEY_TIME_LIMIT,
+	_RECORDER_PROFILE_KEY_AUDIO_DEVICE,
+	_RECORDER_PROFILE_KEY_RECORDING_ORIENTATION,
+	_RECORDER_PROFILE_KEY_MUTE,
+	_RECORDER_PROFILE_KEY_RECORDING_MOTION_RATE,
+	_RECORDER_PROFILE_KEY_FILENAME,
+	_RECORDER_PROFILE_KEY_NUM
+}_recorder_profile_key_e;
+
+typedef enum {
+	_RECORDER_PROFILE_VALUE_INT = 0,
+	_RECORDER_PROFILE_VALUE_DOUBLE,
+	_RECORDER_PROFILE_VALUE_STRING
+}_recorder_profile_value_type_e;
+
+static const unsigned char __profile_key_type[_RECORDER_PROFILE_KEY_NUM] = {
+	[_RECORDER_PROFILE_KEY_FILE_FORMAT] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_AUDIO_ENCODER] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_VIDEO_ENCODER] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_AUDIO_SAMPLERATE] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_AUDIO_CHANNEL] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_AUDIO_ENCODER_BITRATE] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_VIDEO_ENCODER_BITRATE] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_SIZE_LIMIT] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_TIME_LIMIT] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_AUDIO_DEVICE] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_RECORDING_ORIENTATION] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_MUTE] = _RECORDER_PROFILE_VALUE_INT,
+	[_RECORDER_PROFILE_KEY_RECORDING_MOTION_RATE] = _RECORDER_PROFILE_VALUE_DOUBLE,
+	[_RECORDER_PROFILE_KEY_FILENAME] = _RECORDER_PROFILE_VALUE_STRING,
+};
+
+/* keys which are valid only in video recorder */
+#define _RECORDER_PROFILE_VIDEO_KEYS	((1 << _RECORDER_PROFILE_KEY_VIDEO_ENCODER) | \
+					(1 << _RECORDER_PROFILE_KEY_VIDEO_ENCODER_BITRATE) | \
+					(1 << _RECORDER_PROFILE_KEY_RECORDING_ORIENTATION) | \
+					(1 << _RECORDER_PROFILE_KEY_RECORDING_MOTION_RATE))
+
+/*
+ * Profiles hold public (CAPI) values, so serialized profiles do not depend on the core.
+ * A registered profile is immutable and shared, validation result is kept for audio recorders.
+ */
+typedef struct recorder_profile_s {
+	char *name;
+	volatile int ref_count;
+	bool registered;
+	unsigned int mask;	/* bit mask of _recorder_profile_key_e */
+	_recorder_attr_value_u values[_RECORDER_PROFILE_KEY_NUM];
+	char *filename;
+	unsigned int validated;	/* bit mask of _recorder_type_e, only audio is kept */
+	unsigned int invalid;	/* bit mask of _recorder_type_e */
+} recorder_profile_s;
+
+G_LOCK_DEFINE_STATIC(profile);
+static GHashTable *__profile_registry;
+
+static void __profile_unref(gpointer data){
+	recorder_profile_s *profile = (recorder_profile_s*)data;
+	if( g_atomic_int_dec_and_test(&profile->ref_count) ){
+		g_free(profile->name);
+		g_free(profile->filename);
+		g_free(profile);
+	}
+}
+
+static recorder_profile_s *__profile_new(const char *name){
+	recorder_profile_s *profile = g_new0(recorder_profile_s, 1);
+	profile->name = g_strdup(name);
+	profile->ref_count = 1;
+	return profile;
+}
+
+static int __profile_set(recorder_profile_h profile, _recorder_profile_key_e key, int value, const char *func){
+	if( profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	if( profile->registered ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x) : profile [%s] is registered", func, RECORDER_ERROR_INVALID_STATE, profile->name);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+	profile->values[key].value_int = value;
+	profile->mask |= (1 << key);
+	profile->validated = 0;
+	profile->invalid = 0;
+	return RECORDER_ERROR_NONE;
+}
+
+recorder_profile_h _recorder_profile_ref(recorder_profile_h profile){
+	g_atomic_int_inc(&profile->ref_count);
+	return profile;
+}
+
+int recorder_profile_create(const char *name, recorder_profile_h *profile){
+	if( name == NULL || name[0] == '\0' || profile == NULL ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x)", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+	*profile = __profile_new(name);
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_profile_destroy(recorder_profile_h profile){
+	if( profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	__profile_unref(profile);
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_profile_get_name(recorder_profile_h profile, char **name){
+	if( profile == NULL || name == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	*name = strdup(profile->name);
+	if( *name == NULL )
+		return RECORDER_ERROR_OUT_OF_MEMORY;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_profile_set_file_format(recorder_profile_h profile, recorder_file_format_e format){
+	if( format < RECORDER_FILE_FORMAT_3GP || format > RECORDER_FILE_FORMAT_WAV )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_FILE_FORMAT, format, __func__);
+}
+
+int recorder_profile_set_audio_encoder(recorder_profile_h profile, recorder_audio_codec_e codec){
+	if( codec != RECORDER_AUDIO_CODEC_DISABLE && ( codec < RECORDER_AUDIO_CODEC_AMR || codec > RECORDER_AUDIO_CODEC_PCM) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_AUDIO_ENCODER, codec, __func__);
+}
+
+int recorder_profile_set_video_encoder(recorder_profile_h profile, recorder_video_codec_e codec){
+	if( codec < RECORDER_VIDEO_CODEC_H263 || codec > RECORDER_VIDEO_CODEC_THEORA )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_VIDEO_ENCODER, codec, __func__);
+}
+
+int recorder_profile_set_audio_samplerate(recorder_profile_h profile, int samplerate){
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_AUDIO_SAMPLERATE, samplerate, __func__);
+}
+
+int recorder_profile_set_audio_channel(recorder_profile_h profile, int channel_count){
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_AUDIO_CHANNEL, channel_count, __func__);
+}
+
+int recorder_profile_set_audio_encoder_bitrate(recorder_profile_h profile, int bitrate){
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_AUDIO_ENCODER_BITRATE, bitrate, __func__);
+}
+
+int recorder_profile_set_video_encoder_bitrate(recorder_profile_h profile, int bitrate){
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_VIDEO_ENCODER_BITRATE, bitrate, __func__);
+}
+
+int recorder_profile_set_size_limit(recorder_profile_h profile, int kbyte){
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_SIZE_LIMIT, kbyte, __func__);
+}
+
+int recorder_profile_set_time_limit(recorder_profile_h profile, int second){
+	return __profile_set(profile, _RECORDER_PROFILE_KEY_TIME_LIMIT, second, __func__);
+}
+
+int recorder_profile_register(recorder_profile_h profile){
+	if( profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+
+	G_LOCK(profile);
+	if( __profile_registry == NULL )
+		__profile_registry = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, __profile_unref);
+	profile->registered = true;
+	g_atomic_int_inc(&profile->ref_count);
+	g_hash_table_replace(__profile_registry, profile->name, profile);
+	G_UNLOCK(profile);
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_profile_unregister(const char *name){
+	if( name == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	int ret = RECORDER_ERROR_INVALID_PARAMETER;
+
+	G_LOCK(profile);
+	if( __profile_registry && g_hash_table_remove(__profile_registry, name) )
+		ret = RECORDER_ERROR_NONE;
+	G_UNLOCK(profile);
+
+	return ret;
+}
+
+int recorder_profile_lookup(const char *name, recorder_profile_h *profile){
+	if( name == NULL || profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_profile_s *found = NULL;
+
+	G_LOCK(profile);
+	if( __profile_registry )
+		found = g_hash_table_lookup(__profile_registry, name);
+	if( found )
+		g_atomic_int_inc(&found->ref_count);
+	G_UNLOCK(profile);
+
+	if( found == NULL ){
+		LOGE("[%s] profile [%s] is not registered", __func__, name);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+	*profile = found;
+	return RECORDER_ERROR_NONE;
+}
+
+/*
+ * Serialized layout (host byte order)
+ *  uint32 magic, uint16 version, uint16 entry count, uint16 name length, name
+ *  entries : uint8 key, uint8 value type, value (int32, double or uint16 length + string)
+ * Unknown keys are skipped on load, so newer blobs stay readable.
+ */
+int recorder_profile_serialize(recorder_profile_h profile, void **data, int *size){
+	if( profile == NULL || data == NULL || size == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+
+	uint16_t name_len = strlen(profile->name);
+	uint16_t count = 0;
+	int total = sizeof(uint32_t) + sizeof(uint16_t) * 3 + name_len;
+	int i;
+
+	for( i = 0 ; i < _RECORDER_PROFILE_KEY_NUM ; i++ ){
+		if( !(profile->mask & (1 << i)) )
+			continue;
+		total += sizeof(uint8_t) * 2;
+		switch( __profile_key_type[i] ){
+			case _RECORDER_PROFILE_VALUE_INT:
+				total += sizeof(int32_t);
+				break;
+			case _RECORDER_PROFILE_VALUE_DOUBLE:
+				total += sizeof(double);
+				break;
+			case _RECORDER_PROFILE_VALUE_STRING:
+				total += sizeof(uint16_t) + strlen(profile->filename);
+				break;
+		}
+		count++;
+	}
+
+	unsigned char *blob = malloc(total);
+	if( blob == NULL ){
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __func__, RECORDER_ERROR_OUT_OF_MEMORY);
+		return RECORDER_ERROR_OUT_OF_MEMORY;
+	}
+
+	unsigned char *pos = blob;
+	uint32_t magic = RECORDER_PROFILE_MAGIC;
+	uint16_t version = RECORDER_PROFILE_VERSION;
+	memcpy(pos, &magic, sizeof(magic)); pos += sizeof(magic);
+	memcpy(pos, &version, sizeof(version)); pos += sizeof(version);
+	memcpy(pos, &count, sizeof(count)); pos += sizeof(count);
+	memcpy(pos, &name_len, sizeof(name_len)); pos += sizeof(name_len);
+	memcpy(pos, profile->name, name_len); pos += name_len;
+
+	for( i = 0 ; i < _RECORDER_PROFILE_KEY_NUM ; i++ ){
+		if( !(profile->mask & (1 << i)) )
+			continue;
+		*pos++ = i;
+		*pos++ = __profile_key_type[i];
+		switch( __profile_key_type[i] ){
+			case _RECORDER_PROFILE_VALUE_INT:
+			{
+				int32_t value = profile->values[i].value_int;
+				memcpy(pos, &value, sizeof(value)); pos += sizeof(value);
+				break;
+			}
+			case _RECORDER_PROFILE_VALUE_DOUBLE:
+				memcpy(pos, &profile->values[i].value_double, sizeof(double)); pos += sizeof(double);
+				break;
+			case _RECORDER_PROFILE_VALUE_STRING:
+			{
+				uint16_t len = strlen(profile->filename);
+				memcpy(pos, &len, sizeof(len)); pos += sizeof(len);
+				memcpy(pos, profile->filename, len); pos += len;
+				break;
+			}
+		}
+	}
+
+	*data = blob;
+	*size = total;
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_profile_deserialize(const void *data, int size, recorder_profile_h *profile){
+	if( data == NULL || size <= 0 || profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+
+	const unsigned char *pos = data;
+	const unsigned char *end = pos + size;
+	uint32_t magic;
+	uint16_t version;
+	uint16_t count;
+	uint16_t len;
+
+	if( end - pos < (int)(sizeof(uint32_t) + sizeof(uint16_t) * 3) )
+		goto invalid;
+	memcpy(&magic, pos, sizeof(magic)); pos += sizeof(magic);
+	memcpy(&version, pos, sizeof(version)); pos += sizeof(version);
+	memcpy(&count, pos, sizeof(count)); pos += sizeof(count);
+	memcpy(&len, pos, sizeof(len)); pos += sizeof(len);
+	if( magic != RECORDER_PROFILE_MAGIC || version > RECORDER_PROFILE_VERSION || len == 0 || end - pos < len )
+		goto invalid;
+
+	char *name = g_strndup((const char*)pos, len);
+	pos += len;
+	recorder_profile_s *result = __profile_new(name);
+	g_free(name);
+
+	while( count-- > 0 ){
+		if( end - pos < 2 )
+			goto invalid_entry;
+		uint8_t key = *pos++;
+		uint8_t type = *pos++;
+		int32_t value;
+		bool known = key < _RECORDER_PROFILE_KEY_NUM;
+
+		if( known && __profile_key_type[key] != type )
+			goto invalid_entry;
+
+		switch( type ){
+			case _RECORDER_PROFILE_VALUE_INT:
+				if( end - pos < (int)sizeof(int32_t) )
+					goto invalid_entry;
+				memcpy(&value, pos, sizeof(value));
+				if( known )
+					result->values[key].value_int = value;
+				pos += sizeof(value);
+				break;
+			case _RECORDER_PROFILE_VALUE_DOUBLE:
+				if( end - pos < (int)sizeof(double) )
+					goto invalid_entry;
+				if( known )
+					memcpy(&result->values[key].value_double, pos, sizeof(double));
+				pos += sizeof(double);
+				break;
+			case _RECORDER_PROFILE_VALUE_STRING:
+				if( end - pos < (int)sizeof(uint16_t) )
+					goto invalid_entry;
+				memcpy(&len, pos, sizeof(len));
+				pos += sizeof(len);
+				if( end - pos < len || (known && len == 0) )
+					goto invalid_entry;
+				if( known ){
+					g_free(result->filename);
+					result->filename = g_strndup((const char*)pos, len);
+				}
+				pos += len;
+				break;
+			default:
+				goto invalid_entry;
+		}
+		if( known )
+			result->mask |= (1 << key);
+	}
+
+	*profile = result;
+	return RECORDER_ERROR_NONE;
+
+invalid_entry:
+	__profile_unref(result);
+invalid:
+	LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x) : malformed profile data", __func__, RECORDER_ERROR_INVALID_PARAMETER);
+	return RECORDER_ERROR_INVALID_PARAMETER;
+}
+
+static bool __profile_find_value(int value, int *target){
+	if( *target == value ){
+		*target = -1;
+		return false;
+	}
+	return true;
+}
+
+static bool __profile_find_file_format_cb(recorder_file_format_e format, void *user_data){
+	return __profile_find_value(format, (int*)user_data);
+}
+
+static bool __profile_find_audio_encoder_cb(recorder_audio_codec_e codec, void *user_data){
+	return __profile_find_value(codec, (int*)user_data);
+}
+
+static bool __profile_find_video_encoder_cb(recorder_video_codec_e codec, void *user_data){
+	return __profile_find_value(codec, (int*)user_data);
+}
+
+static bool __profile_is_supported_value(recorder_h recorder, _recorder_profile_key_e key, int value){
+	int target = value;
+	switch( key ){
+		case _RECORDER_PROFILE_KEY_FILE_FORMAT:
+			recorder_foreach_supported_file_format(recorder, __profile_find_file_format_cb, &target);
+			break;
+		case _RECORDER_PROFILE_KEY_AUDIO_ENCODER:
+			if( value == RECORDER_AUDIO_CODEC_DISABLE )
+				return true;
+			recorder_foreach_supported_audio_encoder(recorder, __profile_find_audio_encoder_cb, &target);
+			break;
+		case _RECORDER_PROFILE_KEY_VIDEO_ENCODER:
+			recorder_foreach_supported_video_encoder(recorder, __profile_find_video_encoder_cb, &target);
+			break;
+		default:
+			return true;
+	}
+	return target == -1;
+}
+
+/*
+ * checks the profile against the capabilities of the recorder.
+ * Audio capabilities are shared by the process, so the result is kept for every audio recorder.
+ * Video capabilities depend on the camera device of each handle, a video recorder is always checked.
+ */
+static bool __profile_validate(recorder_s *handle, recorder_profile_s *profile){
+	unsigned int type_bit = 1 << handle->type;
+	bool cached = handle->type == _RECORDER_TYPE_AUDIO;
+	bool valid = true;
+	int i;
+
+	G_LOCK(profile);
+	if( cached && (profile->validated & type_bit) ){
+		valid = !(profile->invalid & type_bit);
+		G_UNLOCK(profile);
+		return valid;
+	}
+	G_UNLOCK(profile);
+
+	for( i = 0 ; i < _RECORDER_PROFILE_KEY_NUM && valid ; i++ ){
+		if( !(profile->mask & (1 << i)) )
+			continue;
+		if( handle->type == _RECORDER_TYPE_AUDIO && (_RECORDER_PROFILE_VIDEO_KEYS & (1 << i)) ){
+			LOGE("[%s] profile [%s] has video attributes for audio recorder", __func__, profile->name);
+			valid = false;
+		}else if( __profile_key_type[i] == _RECORDER_PROFILE_VALUE_INT &&
+			!__profile_is_supported_value((recorder_h)handle, i, profile->values[i].value_int) ){
+			LOGE("[%s] profile [%s] has unsupported value(%d) of key(%d)", __func__, profile->name, profile->values[i].value_int, i);
+			valid = false;
+		}
+	}
+
+	if( !cached )
+		return valid;
+
+	G_LOCK(profile);
+	profile->validated |= type_bit;
+	if( !valid )
+		profile->invalid |= type_bit;
+	G_UNLOCK(profile);
+
+	return valid;
+}
+
+int recorder_apply_profile(recorder_h recorder, recorder_profile_h profile){
+	if( recorder == NULL || profile == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+	char *error_attr = NULL;
+	int ret;
+	int i;
+
+	if( !__profile_validate(handle, profile) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+
+	ret = recorder_attr_begin(recorder);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+
+	for( i = 0 ; i < _RECORDER_PROFILE_KEY_NUM && ret == RECORDER_ERROR_NONE ; i++ ){
+		if( !(profile->mask & (1 << i)) )
+			continue;
+		int value = profile->values[i].value_int;
+		switch( i ){
+			case _RECORDER_PROFILE_KEY_FILE_FORMAT:
+				ret = recorder_set_file_format(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_ENCODER:
+				ret = recorder_set_audio_encoder(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_VIDEO_ENCODER:
+				ret = recorder_set_video_encoder(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_SAMPLERATE:
+				ret = recorder_attr_set_audio_samplerate(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_CHANNEL:
+				ret = recorder_attr_set_audio_channel(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_ENCODER_BITRATE:
+				ret = recorder_attr_set_audio_encoder_bitrate(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_VIDEO_ENCODER_BITRATE:
+				ret = recorder_attr_set_video_encoder_bitrate(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_SIZE_LIMIT:
+				ret = recorder_attr_set_size_limit(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_TIME_LIMIT:
+				ret = recorder_attr_set_time_limit(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_DEVICE:
+				ret = recorder_attr_set_audio_device(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_RECORDING_ORIENTATION:
+				ret = recorder_attr_set_recording_orientation(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_MUTE:
+				ret = recorder_attr_set_mute(recorder, value);
+				break;
+			case _RECORDER_PROFILE_KEY_RECORDING_MOTION_RATE:
+				ret = recorder_attr_set_recording_motion_rate(recorder, profile->values[i].value_double);
+				break;
+			case _RECORDER_PROFILE_KEY_FILENAME:
+				ret = recorder_set_filename(recorder, profile->filename);
+				break;
+		}
+	}
+
+	if( ret != RECORDER_ERROR_NONE ){
+		recorder_attr_rollback(recorder);
+		return ret;
+	}
+
+	ret = recorder_attr_commit(recorder, &error_attr);
+	if( ret != RECORDER_ERROR_NONE )
+		LOGE("[%s] profile [%s] is not applied, rejected attribute [%s]", __func__, profile->name, error_attr ? error_attr : "unknown");
+	if( error_attr )
+		free(error_attr);
+
+	return ret;
+}
+
+#define __RECORDER_CONFIG_NAME	"recorder-config"
+
+int recorder_export_config(recorder_h recorder, void **data, int *size){
+	if( recorder == NULL || data == NULL || size == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_profile_s *config = __profile_new(__RECORDER_CONFIG_NAME);
+	_recorder_attr_value_u *values = config->values;
+	int ret = RECORDER_ERROR_NONE;
+	int i;
+
+	for( i = 0 ; i < _RECORDER_PROFILE_KEY_NUM && ret == RECORDER_ERROR_NONE ; i++ ){
+		if( handle->type == _RECORDER_TYPE_AUDIO && (_RECORDER_PROFILE_VIDEO_KEYS & (1 << i)) )
+			continue;
+		switch( i ){
+			case _RECORDER_PROFILE_KEY_FILE_FORMAT:
+				ret = recorder_get_file_format(recorder, (recorder_file_format_e*)&values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_ENCODER:
+				ret = recorder_get_audio_encoder(recorder, (recorder_audio_codec_e*)&values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_VIDEO_ENCODER:
+				ret = recorder_get_video_encoder(recorder, (recorder_video_codec_e*)&values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_SAMPLERATE:
+				ret = recorder_attr_get_audio_samplerate(recorder, &values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_CHANNEL:
+				ret = recorder_attr_get_audio_channel(recorder, &values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_ENCODER_BITRATE:
+				ret = recorder_attr_get_audio_encoder_bitrate(recorder, &values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_VIDEO_ENCODER_BITRATE:
+				ret = recorder_attr_get_video_encoder_bitrate(recorder, &values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_SIZE_LIMIT:
+				ret = recorder_attr_get_size_limit(recorder, &values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_TIME_LIMIT:
+				ret = recorder_attr_get_time_limit(recorder, &values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_AUDIO_DEVICE:
+				ret = recorder_attr_get_audio_device(recorder, (recorder_audio_device_e*)&values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_RECORDING_ORIENTATION:
+				ret = recorder_attr_get_recording_orientation(recorder, (recorder_rotation_e*)&values[i].value_int);
+				break;
+			case _RECORDER_PROFILE_KEY_MUTE:
+				values[i].value_int = recorder_attr_is_muted(recorder);
+				break;
+			case _RECORDER_PROFILE_KEY_RECORDING_MOTION_RATE:
+				ret = recorder_attr_get_recording_motion_rate(recorder, &values[i].value_double);
+				break;
+			case _RECORDER_PROFILE_KEY_FILENAME:
+			{
+				/* a recorder without target file keeps no filename in the snapshot */
+				char *filename = NULL;
+				if( recorder_get_filename(recorder, &filename) == RECORDER_ERROR_NONE && filename && filename[0] != '\0' )
+					config->filename = g_strdup(filename);
+				free(filename);
+				if( config->filename == NULL )
+					continue;
+				break;
+			}
+		}
+		config->mask |= (1 << i);
+	}
+
+	if( ret == RECORDER_ERROR_NONE )
+		ret = recorder_profile_serialize(config, data, size);
+	__profile_unref(config);
+
+	return ret;
+}
+
+int recorder_import_config(recorder_h recorder, const void *data, int size){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_profile_h config;
+	int ret;
+
+	ret = recorder_profile_deserialize(data, size, &config);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	ret = recorder_apply_profile(recorder, config);
+	__profile_unref(config);
+
+	return ret;
+}
@@ -0,0 +1,184 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Output sink
+ * The core only writes to a path, so the target becomes "/proc/self/fd/N".
+ * For callbacks, N is the write end of a pipe drained by a pump thread. A pipe can not seek,
+ * so only stream formats can be delivered through callbacks.
+ */
+#define RECORDER_SINK_CHUNK	(64 * 1024)
+
+typedef struct _recorder_sink_s {
+	recorder_output_write_cb write_cb;
+	recorder_output_flush_cb flush_cb;
+	void *user_data;
+	int pipe_fd[2];		/* -1 while no take is running */
+	GThread *pump;
+} _recorder_sink_s;
+
+static gpointer __sink_pump(gpointer data){
+	_recorder_sink_s *sink = (_recorder_sink_s*)data;
+	char *buffer = g_malloc(RECORDER_SINK_CHUNK);
+	ssize_t size;
+
+	while( true ){
+		size = read(sink->pipe_fd[0], buffer, RECORDER_SINK_CHUNK);
+		if( size > 0 ){
+			sink->write_cb(buffer, (int)size, sink->user_data);
+		}else if( size < 0 && errno == EINTR ){
+			continue;
+		}else{
+			if( size < 0 )
+				LOGE("[%s] read fail : %s", __func__, strerror(errno));
+			break;
+		}
+	}
+	if( sink->flush_cb )
+		sink->flush_cb(sink->user_data);
+	g_free(buffer);
+
+	return NULL;
+}
+
+static bool __sink_is_stream_format(recorder_s *handle){
+	recorder_file_format_e format = RECORDER_FILE_FORMAT_3GP;
+
+	recorder_get_file_format((recorder_h)handle, &format);
+	return format == RECORDER_FILE_FORMAT_AMR || format == RECORDER_FILE_FORMAT_ADTS;
+}
+
+int _recorder_sink_begin(recorder_s *handle, char **path){
+	_recorder_sink_s *sink = handle->sink;
+
+	if( sink == NULL ){
+		*path = NULL;
+		return RECORDER_ERROR_NONE;
+	}
+	// a take the core has stopped by itself may still hold the previous pipe
+	_recorder_sink_end(handle);
+	if( !__sink_is_stream_format(handle) ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : the file format needs a seekable output", __func__, RECORDER_ERROR_INVALID_OPERATION);
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+	if( pipe(sink->pipe_fd) != 0 ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : pipe fail : %s", __func__, RECORDER_ERROR_INVALID_OPERATION, strerror(errno));
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+	fcntl(sink->pipe_fd[0], F_SETFD, FD_CLOEXEC);
+	fcntl(sink->pipe_fd[1], F_SETFD, FD_CLOEXEC);
+
+	sink->pump = g_thread_new("recorder-sink", __sink_pump, sink);
+	*path = g_strdup_printf("/proc/self/fd/%d", sink->pipe_fd[1]);
+
+	return RECORDER_ERROR_NONE;
+}
+
+void _recorder_sink_end(recorder_s *handle){
+	_recorder_sink_s *sink = handle->sink;
+
+	if( sink == NULL || sink->pipe_fd[1] < 0 )
+		return;
+
+	// the core has closed its own descriptor, this one is the last writer and closing it ends the pump
+	close(sink->pipe_fd[1]);
+	g_thread_join(sink->pump);
+	close(sink->pipe_fd[0]);
+	sink->pipe_fd[0] = sink->pipe_fd[1] = -1;
+	sink->pump = NULL;
+}
+
+void _recorder_sink_destroy(recorder_s *handle){
+	if( handle->sink ){
+		_recorder_sink_end(handle);
+		g_free(handle->sink);
+		handle->sink = NULL;
+	}
+}
+
+int recorder_set_output_cb(recorder_h recorder, recorder_output_write_cb write_cb, recorder_output_flush_cb flush_cb, void *user_data){
+	if( recorder == NULL || write_cb == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_state_e state;
+
+	recorder_get_state(recorder, &state);
+	if( state > RECORDER_STATE_READY ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x)", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+
+	if( handle->sink == NULL ){
+		handle->sink = g_new0(_recorder_sink_s, 1);
+		handle->sink->pipe_fd[0] = handle->sink->pipe_fd[1] = -1;
+	}
+	handle->sink->write_cb = write_cb;
+	handle->sink->flush_cb = flush_cb;
+	handle->sink->user_data = user_data;
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_unset_output_cb(recorder_h recorder){
+	if( recorder == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	recorder_s *handle = (recorder_s*)recorder;
+	recorder_state_e state;
+
+	recorder_get_state(recorder, &state);
+	if( state > RECORDER_STATE_READY ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x)", __func__, RECORDER_ERROR_INVALID_STATE);
+		return RECORDER_ERROR_INVALID_STATE;
+	}
+
+	_recorder_sink_destroy(handle);
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_set_output_fd(recorder_h recorder, int fd){
+	if( recorder == NULL || fd < 0 ) return RECORDER_ERROR_INVALID_PARAMETER;
+	char *path;
+	int flags;
+	int ret;
+
+	flags = fcntl(fd, F_GETFL);
+	if( flags < 0 || (flags & O_ACCMODE) == O_RDONLY ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_PARAMETER(0x%08x) : %d is not a writable descriptor", __func__, RECORDER_ERROR_INVALID_PARAMETER, fd);
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	}
+
+	path = g_strdup_printf("/proc/self/fd/%d", fd);
+	ret = recorder_set_filename(recorder, path);
+	g_free(path);
+
+	return ret;
+}
@@ -0,0 +1,235 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+#ifdef USE_IO_URING
+#include <liburing.h>
+#endif
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+static ssize_t __uring_pwrite(int fd, const void *data, int size, off_t offset){
+	ssize_t ret;
+
+	do{
+		ret = pwrite(fd, data, size, offset);
+	}while( ret < 0 && errno == EINTR );
+
+	return ret;
+}
+
+#ifdef USE_IO_URING
+/*
+ * io_uring writer
+ * One ring serves every recorder of the process. Writers queue their requests and wait, the ring thread
+ * submits everything queued since its last round with a single io_uring_enter(), so concurrent recorders
+ * share the system calls. Write-behind buffers are registered in a sparse fixed buffer table when the kernel allows it.
+ */
+#define RECORDER_URING_DEPTH	64
+#define RECORDER_URING_FIXED_BUFFERS	256
+
+typedef struct _recorder_uring_req_s {
+	int fd;
+	const void *data;
+	int size;
+	off_t offset;
+	int index;		/* fixed buffer, -1 if the memory is not registered */
+	int result;
+	bool done;
+} _recorder_uring_req_s;
+
+static GMutex __uring_lock;
+static GCond __uring_cond;		/* requests queued, wakes the ring thread */
+static GCond __uring_done_cond;		/* requests completed, wakes the writers */
+static GQueue __uring_pending;
+static struct io_uring __uring;
+static GThread *__uring_thread;
+static bool __uring_failed;		/* the ring can not be set up, writes fall back to pwrite() */
+static bool __uring_fixed;		/* the fixed buffer table is available */
+static bool __uring_slot_used[RECORDER_URING_FIXED_BUFFERS];
+
+static gpointer __uring_thread_func(gpointer data){
+	_recorder_uring_req_s *req;
+	struct io_uring_sqe *sqe;
+	struct io_uring_cqe *cqe;
+	int inflight = 0;
+	int queued;
+	int ret;
+
+	g_mutex_lock(&__uring_lock);
+	while( true ){
+		while( inflight == 0 && g_queue_is_empty(&__uring_pending) )
+			g_cond_wait(&__uring_cond, &__uring_lock);
+
+		queued = 0;
+		while( inflight + queued < RECORDER_URING_DEPTH && (req = g_queue_pop_head(&__uring_pending)) != NULL ){
+			sqe = io_uring_get_sqe(&__uring);
+			if( sqe == NULL ){
+				g_queue_push_head(&__uring_pending, req);
+				break;
+			}
+			if( req->index >= 0 )
+				io_uring_prep_write_fixed(sqe, req->fd, req->data, req->size, req->offset, req->index);
+			else
+				io_uring_prep_write(sqe, req->fd, req->data, req->size, req->offset);
+			io_uring_sqe_set_data(sqe, req);
+			queued++;
+		}
+		g_mutex_unlock(&__uring_lock);
+
+		// requests queued while waiting here go out together in the next round
+		ret = io_uring_submit_and_wait(&__uring, 1);
+		if( ret >= 0 )
+			inflight += ret;
+		else if( ret != -EINTR )
+			LOGE("[%s] submit fail : %s", __func__, strerror(-ret));
+
+		g_mutex_lock(&__uring_lock);
+		while( io_uring_peek_cqe(&__uring, &cqe) == 0 ){
+			req = (_recorder_uring_req_s*)io_uring_cqe_get_data(cqe);
+			req->result = cqe->res;
+			req->done = true;
+			io_uring_cqe_seen(&__uring, cqe);
+			inflight--;
+		}
+		g_cond_broadcast(&__uring_done_cond);
+	}
+	g_mutex_unlock(&__uring_lock);
+
+	return NULL;
+}
+
+/* called with __uring_lock held */
+static bool __uring_setup(void){
+	int ret;
+
+	if( __uring_thread )
+		return true;
+	if( __uring_failed )
+		return false;
+
+	ret = io_uring_queue_init(RECORDER_URING_DEPTH, &__uring, 0);
+	if( ret < 0 ){
+		LOGW("[%s] io_uring is not available, pwrite is used : %s", __func__, strerror(-ret));
+		__uring_failed = true;
+		return false;
+	}
+	ret = io_uring_register_buffers_sparse(&__uring, RECORDER_URING_FIXED_BUFFERS);
+	__uring_fixed = ret == 0;
+	if( !__uring_fixed )
+		LOGW("[%s] fixed buffers are not available : %s", __func__, strerror(-ret));
+	__uring_thread = g_thread_new("recorder-uring", __uring_thread_func, NULL);
+
+	return true;
+}
+
+bool _recorder_uring_available(void){
+	bool ret;
+
+	g_mutex_lock(&__uring_lock);
+	ret = __uring_setup();
+	g_mutex_unlock(&__uring_lock);
+
+	return ret;
+}
+
+void _recorder_uring_register(void *data, int size, int *index){
+	struct iovec iov = { data, size };
+	int i;
+
+	*index = -1;
+	g_mutex_lock(&__uring_lock);
+	if( __uring_setup() && __uring_fixed ){
+		for( i = 0 ; i < RECORDER_URING_FIXED_BUFFERS ; i++ ){
+			if( __uring_slot_used[i] )
+				continue;
+			if( io_uring_register_buffers_update_tag(&__uring, i, &iov, NULL, 1) == 1 ){
+				__uring_slot_used[i] = true;
+				*index = i;
+			}
+			break;
+		}
+	}
+	g_mutex_unlock(&__uring_lock);
+}
+
+void _recorder_uring_unregister(int index){
+	struct iovec iov = { NULL, 0 };
+
+	if( index < 0 )
+		return;
+	g_mutex_lock(&__uring_lock);
+	io_uring_register_buffers_update_tag(&__uring, index, &iov, NULL, 1);
+	__uring_slot_used[index] = false;
+	g_mutex_unlock(&__uring_lock);
+}
+
+ssize_t _recorder_uring_pwrite(int fd, const void *data, int size, off_t offset, int index){
+	_recorder_uring_req_s req = { fd, data, size, offset, index, 0, false };
+
+	g_mutex_lock(&__uring_lock);
+	if( !__uring_setup() ){
+		g_mutex_unlock(&__uring_lock);
+		return __uring_pwrite(fd, data, size, offset);
+	}
+	g_queue_push_tail(&__uring_pending, &req);
+	g_cond_signal(&__uring_cond);
+	while( !req.done )
+		g_cond_wait(&__uring_done_cond, &__uring_lock);
+	g_mutex_unlock(&__uring_lock);
+
+	// an operation refused by the ring, or a real error that pwrite() reports again
+	if( req.result < 0 )
+		return __uring_pwrite(fd, data, size, offset);
+
+	return req.result;
+}
+
+#else
+
+bool _recorder_uring_available(void){
+	return false;
+}
+
+void _recorder_uring_register(void *data, int size, int *index){
+	*index = -1;
+}
+
+void _recorder_uring_unregister(int index){
+}
+
+ssize_t _recorder_uring_pwrite(int fd, const void *data, int size, off_t offset, int index){
+	return __uring_pwrite(fd, data, size, offset);
+}
+
+#endif
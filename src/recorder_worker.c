@@ -0,0 +1,77 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <glib.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/* threads shared by all background jobs of the library */
+#define RECORDER_WORKER_MAX_THREADS	4
+
+typedef struct {
+	_recorder_worker_func func;
+	void *data;
+} _recorder_worker_job_s;
+
+G_LOCK_DEFINE_STATIC(worker);
+static GThreadPool *__worker_pool;
+
+static void __worker_thread(gpointer data, gpointer user_data){
+	_recorder_worker_job_s *job = (_recorder_worker_job_s*)data;
+	job->func(job->data);
+	g_free(job);
+}
+
+int _recorder_worker_run(_recorder_worker_func func, void *data){
+	_recorder_worker_job_s *job;
+	GError *error = NULL;
+
+	G_LOCK(worker);
+	if( __worker_pool == NULL ){
+		__worker_pool = g_thread_pool_new(__worker_thread, NULL, RECORDER_WORKER_MAX_THREADS, FALSE, &error);
+		if( __worker_pool == NULL ){
+			G_UNLOCK(worker);
+			LOGE("[%s] worker creation fail : %s", __func__, error ? error->message : "unknown");
+			if( error )
+				g_error_free(error);
+			return RECORDER_ERROR_INVALID_OPERATION;
+		}
+	}
+	G_UNLOCK(worker);
+
+	job = g_new0(_recorder_worker_job_s, 1);
+	job->func = func;
+	job->data = data;
+	if( !g_thread_pool_push(__worker_pool, job, &error) ){
+		LOGE("[%s] job push fail : %s", __func__, error ? error->message : "unknown");
+		if( error )
+			g_error_free(error);
+		g_free(job);
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+
+	return RECORDER_ERROR_NONE;
+}
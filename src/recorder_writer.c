@@ -0,0 +1,553 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <glib.h>
+#include <mm_camcorder.h>
+#include <recorder.h>
+#include <recorder_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_RECORDER"
+
+/*
+ * Write-behind stage
+ * The core only writes to a path, so it gets the write end of a pipe as "/proc/self/fd/N".
+ * A reader thread fills aligned buffers from the pipe and a flusher thread writes full buffers to the file,
+ * the muxer only waits when every buffer of the budget is waiting for storage.
+ */
+#define RECORDER_WRITER_ALIGN	4096
+#define RECORDER_WRITER_BLOCK	(256 * 1024)
+#define RECORDER_WRITER_MIN_KBYTE	8
+
+typedef struct _recorder_writer_buffer_s {
+	char *data;
+	int size;		/* bytes filled */
+	int index;		/* fixed buffer of the shared ring, -1 if not registered */
+} _recorder_writer_buffer_s;
+
+typedef struct _recorder_writer_s {
+	recorder_s *handle;
+	int budget;		/* bytes, 0 if the stage is disabled */
+	bool direct_io;
+	recorder_durability_e durability;
+	int interval;		/* msec of RECORDER_DURABILITY_PERIODIC */
+	recorder_writer_backend_e backend;
+
+	/* running take */
+	char *path;		/* target given by the application, NULL if no take goes through the stage */
+	int pipe_fd[2];
+	int fd;
+	off_t offset;
+	bool direct;		/* fd is still opened with O_DIRECT */
+	int block;
+	GThread *reader;
+	GThread *flusher;
+	GMutex lock;
+	GCond cond;
+	GQueue free_list;
+	GQueue full_list;
+	bool eos;
+	bool dirty;		/* written since the last sync */
+	gint64 synced_at;
+	int held;
+	int error;
+
+	recorder_write_behind_stats_s stats;
+} _recorder_writer_s;
+
+static _recorder_writer_s *__writer_get(recorder_s *handle){
+	if( handle->writer == NULL ){
+		handle->writer = g_new0(_recorder_writer_s, 1);
+		handle->writer->handle = handle;
+		handle->writer->pipe_fd[0] = handle->writer->pipe_fd[1] = -1;
+		handle->writer->fd = -1;
+		g_mutex_init(&handle->writer->lock);
+		g_cond_init(&handle->writer->cond);
+	}
+	return handle->writer;
+}
+
+static bool __writer_is_stream_format(recorder_s *handle){
+	recorder_file_format_e format = RECORDER_FILE_FORMAT_3GP;
+
+	recorder_get_file_format((recorder_h)handle, &format);
+	return format == RECORDER_FILE_FORMAT_AMR || format == RECORDER_FILE_FORMAT_ADTS;
+}
+
+/* the take is lost from here on, the application learns it now instead of at commit */
+static void __writer_report_error(_recorder_writer_s *writer){
+	recorder_s *handle = writer->handle;
+
+	if( handle->user_cb[_RECORDER_EVENT_TYPE_ERROR] )
+		((recorder_error_cb)handle->user_cb[_RECORDER_EVENT_TYPE_ERROR])(RECORDER_ERROR_INVALID_OPERATION, handle->state, handle->user_data[_RECORDER_EVENT_TYPE_ERROR]);
+}
+
+static void __writer_write(_recorder_writer_s *writer, _recorder_writer_buffer_s *buffer){
+	int offset = 0;
+	ssize_t size;
+
+	// after a write error the take is drained without being stored, the muxer must not block on the pipe
+	if( writer->error )
+		return;
+
+	// only the last buffer of a take is short, O_DIRECT needs whole blocks
+	if( writer->direct && buffer->size % RECORDER_WRITER_ALIGN ){
+		fcntl(writer->fd, F_SETFL, fcntl(writer->fd, F_GETFL) & ~O_DIRECT);
+		writer->direct = false;
+	}
+
+	while( offset < buffer->size ){
+		if( writer->backend == RECORDER_WRITER_BACKEND_IO_URING )
+			size = _recorder_uring_pwrite(writer->fd, buffer->data + offset, buffer->size - offset, writer->offset, buffer->index);
+		else
+			size = pwrite(writer->fd, buffer->data + offset, buffer->size - offset, writer->offset);
+		if( size < 0 ){
+			if( errno == EINTR )
+				continue;
+			writer->error = errno;
+			LOGE("[%s] write fail : %s", __func__, strerror(errno));
+			__writer_report_error(writer);
+			return;
+		}
+		offset += size;
+		writer->offset += size;
+	}
+
+	g_mutex_lock(&writer->lock);
+	writer->stats.write_count++;
+	writer->stats.bytes_written += offset;
+	writer->dirty = true;
+	g_mutex_unlock(&writer->lock);
+}
+
+static gpointer __writer_read(gpointer data){
+	_recorder_writer_s *writer = (_recorder_writer_s*)data;
+	_recorder_writer_buffer_s *buffer = NULL;
+	struct pollfd pfd = { writer->pipe_fd[0], POLLIN, 0 };
+	// a partial buffer can only be handed over to a page cache write
+	int timeout = writer->durability == RECORDER_DURABILITY_PERIODIC && !writer->direct ? writer->interval : -1;
+	ssize_t size;
+
+	while( true ){
+		if( buffer == NULL ){
+			g_mutex_lock(&writer->lock);
+			if( g_queue_is_empty(&writer->free_list) ){
+				writer->stats.stall_count++;
+				while( g_queue_is_empty(&writer->free_list) )
+					g_cond_wait(&writer->cond, &writer->lock);
+			}
+			buffer = g_queue_pop_head(&writer->free_list);
+			g_mutex_unlock(&writer->lock);
+			buffer->size = 0;
+		}
+
+		if( timeout > 0 && poll(&pfd, 1, timeout) == 0 ){
+			if( buffer->size > 0 ){
+				g_mutex_lock(&writer->lock);
+				g_queue_push_tail(&writer->full_list, buffer);
+				g_cond_broadcast(&writer->cond);
+				g_mutex_unlock(&writer->lock);
+				buffer = NULL;
+			}
+			continue;
+		}
+
+		size = read(writer->pipe_fd[0], buffer->data + buffer->size, writer->block - buffer->size);
+		if( size > 0 ){
+			buffer->size += size;
+			g_mutex_lock(&writer->lock);
+			writer->held += size;
+			if( writer->held > writer->stats.high_water )
+				writer->stats.high_water = writer->held;
+			if( buffer->size == writer->block ){
+				g_queue_push_tail(&writer->full_list, buffer);
+				g_cond_broadcast(&writer->cond);
+				buffer = NULL;
+			}
+			g_mutex_unlock(&writer->lock);
+		}else if( size < 0 && errno == EINTR ){
+			continue;
+		}else{
+			if( size < 0 )
+				LOGE("[%s] read fail : %s", __func__, strerror(errno));
+			break;
+		}
+	}
+
+	g_mutex_lock(&writer->lock);
+	if( buffer && buffer->size > 0 )
+		g_queue_push_tail(&writer->full_list, buffer);
+	else if( buffer )
+		g_queue_push_tail(&writer->free_list, buffer);
+	writer->eos = true;
+	g_cond_broadcast(&writer->cond);
+	g_mutex_unlock(&writer->lock);
+
+	return NULL;
+}
+
+static void __writer_sync(_recorder_writer_s *writer){
+	int ret;
+
+	g_mutex_unlock(&writer->lock);
+	ret = fdatasync(writer->fd);
+	g_mutex_lock(&writer->lock);
+	if( ret != 0 )
+		LOGW("[%s] fdatasync fail : %s", __func__, strerror(errno));
+	writer->stats.sync_count++;
+	writer->synced_at = g_get_monotonic_time();
+	writer->dirty = false;
+}
+
+static gpointer __writer_flush(gpointer data){
+	_recorder_writer_s *writer = (_recorder_writer_s*)data;
+	bool periodic = writer->durability == RECORDER_DURABILITY_PERIODIC;
+	_recorder_writer_buffer_s *buffer;
+	gint64 deadline;
+
+	g_mutex_lock(&writer->lock);
+	writer->synced_at = g_get_monotonic_time();
+	while( true ){
+		deadline = writer->synced_at + writer->interval * G_TIME_SPAN_MILLISECOND;
+		if( periodic && writer->dirty && g_get_monotonic_time() >= deadline ){
+			__writer_sync(writer);
+			continue;
+		}
+
+		buffer = g_queue_pop_head(&writer->full_list);
+		if( buffer == NULL ){
+			if( writer->eos )
+				break;
+			if( periodic && writer->dirty )
+				g_cond_wait_until(&writer->cond, &writer->lock, deadline);
+			else
+				g_cond_wait(&writer->cond, &writer->lock);
+			continue;
+		}
+		g_mutex_unlock(&writer->lock);
+
+		__writer_write(writer, buffer);
+
+		g_mutex_lock(&writer->lock);
+		writer->held -= buffer->size;
+		g_queue_push_tail(&writer->free_list, buffer);
+		g_cond_broadcast(&writer->cond);
+	}
+	g_mutex_unlock(&writer->lock);
+
+	return NULL;
+}
+
+static void __writer_free_buffers(_recorder_writer_s *writer){
+	_recorder_writer_buffer_s *buffer;
+
+	while( (buffer = g_queue_pop_head(&writer->free_list)) != NULL ){
+		_recorder_uring_unregister(buffer->index);
+		free(buffer->data);
+		g_free(buffer);
+	}
+	while( (buffer = g_queue_pop_head(&writer->full_list)) != NULL ){
+		_recorder_uring_unregister(buffer->index);
+		free(buffer->data);
+		g_free(buffer);
+	}
+}
+
+static char *__writer_target(recorder_s *handle, const char *filename){
+	char *path = NULL;
+
+	if( filename ){
+		path = strdup(filename);
+	}else{
+		g_mutex_lock(&handle->async_lock);
+		if( handle->staged_filename )
+			path = strdup(handle->staged_filename);
+		g_mutex_unlock(&handle->async_lock);
+		if( path == NULL )
+			recorder_get_filename((recorder_h)handle, &path);
+	}
+	// descriptors given by the application are written directly
+	if( path && strncmp(path, "/proc/self/fd/", strlen("/proc/self/fd/")) == 0 ){
+		free(path);
+		path = NULL;
+	}
+	return path;
+}
+
+int _recorder_writer_begin(recorder_s *handle, const char *filename, char **path){
+	_recorder_writer_s *writer = handle->writer;
+	int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+	int count;
+	int i;
+
+	*path = NULL;
+	// a take the core has stopped by itself may still hold the previous stage
+	if( writer && writer->path )
+		_recorder_writer_end(handle, false);
+	if( writer == NULL || writer->budget == 0 || handle->sink || handle->loop )
+		return RECORDER_ERROR_NONE;
+	if( !__writer_is_stream_format(handle) ){
+		LOGW("[%s] the file format needs a seekable output, written directly", __func__);
+		return RECORDER_ERROR_NONE;
+	}
+	writer->path = __writer_target(handle, filename);
+	if( writer->path == NULL )
+		return RECORDER_ERROR_NONE;
+
+	writer->direct = false;
+	writer->fd = -1;
+	if( writer->direct_io ){
+		writer->fd = open(writer->path, flags | O_DIRECT, 0644);
+		if( writer->fd < 0 )
+			LOGW("[%s] O_DIRECT is not available : %s", __func__, strerror(errno));
+		else
+			writer->direct = true;
+	}
+	if( writer->fd < 0 )
+		writer->fd = open(writer->path, flags, 0644);
+	if( writer->fd < 0 ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : can not create [%s] : %s", __func__, RECORDER_ERROR_INVALID_OPERATION, writer->path, strerror(errno));
+		free(writer->path);
+		writer->path = NULL;
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+	if( pipe(writer->pipe_fd) != 0 ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : pipe fail : %s", __func__, RECORDER_ERROR_INVALID_OPERATION, strerror(errno));
+		close(writer->fd);
+		writer->fd = -1;
+		writer->pipe_fd[0] = writer->pipe_fd[1] = -1;
+		free(writer->path);
+		writer->path = NULL;
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+	fcntl(writer->pipe_fd[0], F_SETFD, FD_CLOEXEC);
+	fcntl(writer->pipe_fd[1], F_SETFD, FD_CLOEXEC);
+
+	// whole blocks are aligned, a budget of less than two blocks is split in two
+	writer->block = RECORDER_WRITER_BLOCK;
+	if( writer->budget < 2 * RECORDER_WRITER_BLOCK )
+		writer->block = writer->budget / 2 / RECORDER_WRITER_ALIGN * RECORDER_WRITER_ALIGN;
+	count = writer->budget / writer->block;
+	// the muxer blocks on the pipe less often when it holds a whole block
+	fcntl(writer->pipe_fd[1], F_SETPIPE_SZ, writer->block);
+
+	for( i = 0 ; i < count ; i++ ){
+		_recorder_writer_buffer_s *buffer = g_new0(_recorder_writer_buffer_s, 1);
+		if( posix_memalign((void**)&buffer->data, RECORDER_WRITER_ALIGN, writer->block) != 0 ){
+			g_free(buffer);
+			break;
+		}
+		buffer->index = -1;
+		if( writer->backend == RECORDER_WRITER_BACKEND_IO_URING )
+			_recorder_uring_register(buffer->data, writer->block, &buffer->index);
+		g_queue_push_tail(&writer->free_list, buffer);
+	}
+	if( g_queue_is_empty(&writer->free_list) ){
+		LOGE("[%s] RECORDER_ERROR_OUT_OF_MEMORY(0x%08x) : no buffer for the write-behind stage", __func__, RECORDER_ERROR_OUT_OF_MEMORY);
+		close(writer->pipe_fd[0]);
+		close(writer->pipe_fd[1]);
+		writer->pipe_fd[0] = writer->pipe_fd[1] = -1;
+		close(writer->fd);
+		writer->fd = -1;
+		free(writer->path);
+		writer->path = NULL;
+		return RECORDER_ERROR_OUT_OF_MEMORY;
+	}
+
+	writer->offset = 0;
+	writer->eos = false;
+	writer->dirty = false;
+	writer->held = 0;
+	writer->error = 0;
+	writer->stats.buffer_size = writer->block * g_queue_get_length(&writer->free_list);
+	writer->reader = g_thread_new("recorder-writer-read", __writer_read, writer);
+	writer->flusher = g_thread_new("recorder-writer-flush", __writer_flush, writer);
+	*path = g_strdup_printf("/proc/self/fd/%d", writer->pipe_fd[1]);
+
+	return RECORDER_ERROR_NONE;
+}
+
+char *_recorder_writer_get_path(recorder_s *handle){
+	if( handle->writer == NULL || handle->writer->path == NULL )
+		return NULL;
+	return g_strdup(handle->writer->path);
+}
+
+/* a take written directly is synced through a new descriptor of the same file */
+static void __writer_sync_direct(recorder_s *handle){
+	char *path = NULL;
+	int fd;
+
+	if( handle->sink || recorder_get_filename((recorder_h)handle, &path) != RECORDER_ERROR_NONE || path == NULL )
+		return;
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if( fd >= 0 ){
+		if( fsync(fd) != 0 )
+			LOGW("[%s] fsync fail : %s", __func__, strerror(errno));
+		else
+			handle->writer->stats.sync_count++;
+		close(fd);
+	}
+	free(path);
+}
+
+static void __writer_drain(_recorder_writer_s *writer, bool commit){
+	// the core has closed its own descriptor, this one is the last writer and closing it drains the stage
+	close(writer->pipe_fd[1]);
+	g_thread_join(writer->reader);
+	g_thread_join(writer->flusher);
+	close(writer->pipe_fd[0]);
+	writer->pipe_fd[0] = writer->pipe_fd[1] = -1;
+	writer->reader = writer->flusher = NULL;
+
+	if( commit && writer->durability != RECORDER_DURABILITY_NONE && !writer->error ){
+		if( fsync(writer->fd) != 0 )
+			LOGW("[%s] fsync fail : %s", __func__, strerror(errno));
+		writer->stats.sync_count++;
+	}
+	if( writer->error )
+		LOGE("[%s] [%s] is incomplete : %s", __func__, writer->path, strerror(writer->error));
+	close(writer->fd);
+	writer->fd = -1;
+	__writer_free_buffers(writer);
+}
+
+int _recorder_writer_end(recorder_s *handle, bool commit){
+	_recorder_writer_s *writer = handle->writer;
+	int ret = RECORDER_ERROR_NONE;
+
+	if( writer == NULL )
+		return RECORDER_ERROR_NONE;
+	if( writer->path == NULL ){
+		if( commit && writer->durability == RECORDER_DURABILITY_COMMIT )
+			__writer_sync_direct(handle);
+		return RECORDER_ERROR_NONE;
+	}
+
+	__writer_drain(writer, commit);
+	if( writer->error ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : the take is not stored completely", __func__, RECORDER_ERROR_INVALID_OPERATION);
+		ret = RECORDER_ERROR_INVALID_OPERATION;
+	}
+
+	// the next take is written to the file of the application again
+	mm_camcorder_set_attributes(handle->mm_handle, NULL,
+																MMCAM_TARGET_FILENAME, writer->path, strlen(writer->path),
+																(void*)NULL);
+	free(writer->path);
+	writer->path = NULL;
+
+	return ret;
+}
+
+/* called once the core is destroyed, the target is not restored */
+void _recorder_writer_destroy(recorder_s *handle){
+	_recorder_writer_s *writer = handle->writer;
+
+	if( writer == NULL )
+		return;
+	if( writer->path ){
+		__writer_drain(writer, false);
+		free(writer->path);
+	}
+	g_cond_clear(&writer->cond);
+	g_mutex_clear(&writer->lock);
+	g_free(writer);
+	handle->writer = NULL;
+}
+
+static bool __writer_check_state(recorder_h recorder, const char *func){
+	recorder_state_e state;
+
+	recorder_get_state(recorder, &state);
+	if( state > RECORDER_STATE_READY ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_STATE(0x%08x)", func, RECORDER_ERROR_INVALID_STATE);
+		return false;
+	}
+	return true;
+}
+
+int recorder_set_write_behind(recorder_h recorder, int buffer_kbyte, bool direct_io){
+	if( recorder == NULL || buffer_kbyte < 0 || (buffer_kbyte > 0 && buffer_kbyte < RECORDER_WRITER_MIN_KBYTE) || buffer_kbyte > G_MAXINT / 1024 )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	if( !__writer_check_state(recorder, __func__) )
+		return RECORDER_ERROR_INVALID_STATE;
+
+	_recorder_writer_s *writer = __writer_get((recorder_s*)recorder);
+	writer->budget = buffer_kbyte * 1024;
+	writer->direct_io = direct_io;
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_set_output_durability(recorder_h recorder, recorder_durability_e policy, int interval){
+	if( recorder == NULL || policy < RECORDER_DURABILITY_NONE || policy > RECORDER_DURABILITY_COMMIT ||
+		(policy == RECORDER_DURABILITY_PERIODIC && interval <= 0) )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	if( !__writer_check_state(recorder, __func__) )
+		return RECORDER_ERROR_INVALID_STATE;
+
+	_recorder_writer_s *writer = __writer_get((recorder_s*)recorder);
+	writer->durability = policy;
+	writer->interval = interval;
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_set_write_behind_backend(recorder_h recorder, recorder_writer_backend_e backend){
+	if( recorder == NULL || backend < RECORDER_WRITER_BACKEND_WRITE || backend > RECORDER_WRITER_BACKEND_IO_URING )
+		return RECORDER_ERROR_INVALID_PARAMETER;
+	if( !__writer_check_state(recorder, __func__) )
+		return RECORDER_ERROR_INVALID_STATE;
+	if( backend == RECORDER_WRITER_BACKEND_IO_URING && !_recorder_uring_available() ){
+		LOGE("[%s] RECORDER_ERROR_INVALID_OPERATION(0x%08x) : io_uring is not available", __func__, RECORDER_ERROR_INVALID_OPERATION);
+		return RECORDER_ERROR_INVALID_OPERATION;
+	}
+
+	__writer_get((recorder_s*)recorder)->backend = backend;
+
+	return RECORDER_ERROR_NONE;
+}
+
+int recorder_get_write_behind_stats(recorder_h recorder, recorder_write_behind_stats_s *stats){
+	if( recorder == NULL || stats == NULL ) return RECORDER_ERROR_INVALID_PARAMETER;
+	_recorder_writer_s *writer = ((recorder_s*)recorder)->writer;
+
+	if( writer == NULL ){
+		memset(stats, 0, sizeof(recorder_write_behind_stats_s));
+		return RECORDER_ERROR_NONE;
+	}
+	g_mutex_lock(&writer->lock);
+	*stats = writer->stats;
+	g_mutex_unlock(&writer->lock);
+
+	return RECORDER_ERROR_NONE;
+}
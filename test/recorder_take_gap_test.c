@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License. 
+*/
+
+/*
+ * Measures the gap between two consecutive audio takes :
+ * recorder_commit() + recorder_start() against recorder_start_next_take().
+ * usage : recorder_take_gap_test [takes] [take length in ms] [directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <glib.h>
+#include <recorder.h>
+
+#define DEFAULT_TAKES	10
+#define DEFAULT_TAKE_MS	500
+
+typedef int (*next_take_func)(recorder_h recorder, const char *filename);
+
+static int commit_then_start(recorder_h recorder, const char *filename){
+	int ret;
+	ret = recorder_commit(recorder);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	ret = recorder_set_filename(recorder, filename);
+	if( ret != RECORDER_ERROR_NONE )
+		return ret;
+	return recorder_start(recorder);
+}
+
+static int run(const char *name, next_take_func next_take, int takes, int take_ms, const char *dir){
+	recorder_h recorder;
+	char filename[256];
+	gint64 begin, gap, total = 0, worst = 0;
+	int ret;
+	int i;
+
+	ret = recorder_create_audiorecorder(&recorder);
+	if( ret != RECORDER_ERROR_NONE ){
+		printf("%s : recorder_create_audiorecorder fail %x\n", name, ret);
+		return ret;
+	}
+	recorder_set_file_format(recorder, RECORDER_FILE_FORMAT_AMR);
+	recorder_set_audio_encoder(recorder, RECORDER_AUDIO_CODEC_AMR);
+	snprintf(filename, sizeof(filename), "%s/take_gap_%s_0.amr", dir, name);
+	recorder_set_filename(recorder, filename);
+
+	ret = recorder_prepare(recorder);
+	if( ret == RECORDER_ERROR_NONE )
+		ret = recorder_start(recorder);
+
+	for( i = 1 ; i < takes && ret == RECORDER_ERROR_NONE ; i++ ){
+		usleep(take_ms * 1000);
+		snprintf(filename, sizeof(filename), "%s/take_gap_%s_%d.amr", dir, name, i);
+		begin = g_get_monotonic_time();
+		ret = next_take(recorder, filename);
+		gap = g_get_monotonic_time() - begin;
+		total += gap;
+		if( gap > worst )
+			worst = gap;
+	}
+
+	if( ret == RECORDER_ERROR_NONE ){
+		usleep(take_ms * 1000);
+		recorder_commit(recorder);
+		printf("%-20s takes %3d  average gap %8lld us  worst gap %8lld us\n", name, takes,
+			takes > 1 ? (long long)(total / (takes - 1)) : 0LL, (long long)worst);
+	}else{
+		printf("%s : fail at take %d %x\n", name, i, ret);
+	}
+
+	recorder_unprepare(recorder);
+	recorder_destroy(recorder);
+	return ret;
+}
+
+int main(int argc, char **argv){
+	int takes = argc > 1 ? atoi(argv[1]) : DEFAULT_TAKES;
+	int take_ms = argc > 2 ? atoi(argv[2]) : DEFAULT_TAKE_MS;
+	const char *dir = argc > 3 ? argv[3] : "/tmp";
+	int fail = 0;
+
+	if( takes < 2 )
+		takes = 2;
+
+	if( run("commit_start", commit_then_start, takes, take_ms, dir) != RECORDER_ERROR_NONE )
+		fail++;
+	if( run("start_next_take", recorder_start_next_take, takes, take_ms, dir) != RECORDER_ERROR_NONE )
+		fail++;
+
+	return fail;
+}
@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License. 
+*/
+
+
+/*
+ * Compares the write-behind backends with many concurrent audio recorders :
+ * pwrite() from each recorder against the io_uring shared by the process.
+ * usage : recorder_writer_backend_test [recorders] [take length in ms] [directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <glib.h>
+#include <recorder.h>
+
+#define DEFAULT_RECORDERS	32
+#define DEFAULT_TAKE_MS	5000
+#define WRITE_BEHIND_KBYTE	512
+
+static gint64 cpu_time(void){
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (gint64)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * G_TIME_SPAN_SECOND + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+static int run(const char *name, recorder_writer_backend_e backend, int count, int take_ms, const char *dir){
+	recorder_h *recorders = g_new0(recorder_h, count);
+	recorder_write_behind_stats_s stats;
+	unsigned long long bytes = 0;
+	int writes = 0, stalls = 0, high_water = 0;
+	char filename[256];
+	gint64 begin, cpu;
+	int ret = RECORDER_ERROR_NONE;
+	int started = 0;
+	int i;
+
+	for( i = 0 ; i < count ; i++ ){
+		ret = recorder_create_audiorecorder(&recorders[i]);
+		if( ret != RECORDER_ERROR_NONE ){
+			printf("%s : recorder_create_audiorecorder %d fail %x\n", name, i, ret);
+			recorders[i] = NULL;
+			break;
+		}
+		recorder_set_file_format(recorders[i], RECORDER_FILE_FORMAT_ADTS);
+		recorder_set_audio_encoder(recorders[i], RECORDER_AUDIO_CODEC_AAC);
+		snprintf(filename, sizeof(filename), "%s/writer_%s_%d.aac", dir, name, i);
+		recorder_set_filename(recorders[i], filename);
+		recorder_set_write_behind(recorders[i], WRITE_BEHIND_KBYTE, false);
+		ret = recorder_set_write_behind_backend(recorders[i], backend);
+		if( ret != RECORDER_ERROR_NONE ){
+			printf("%s : backend is not available %x\n", name, ret);
+			break;
+		}
+		ret = recorder_prepare(recorders[i]);
+		if( ret != RECORDER_ERROR_NONE ){
+			printf("%s : recorder_prepare %d fail %x\n", name, i, ret);
+			break;
+		}
+	}
+
+	begin = g_get_monotonic_time();
+	cpu = cpu_time();
+	for( i = 0 ; i < count && ret == RECORDER_ERROR_NONE ; i++ ){
+		ret = recorder_start(recorders[i]);
+		if( ret != RECORDER_ERROR_NONE )
+			printf("%s : recorder_start %d fail %x\n", name, i, ret);
+		else
+			started++;
+	}
+	if( ret == RECORDER_ERROR_NONE )
+		usleep(take_ms * 1000);
+	for( i = 0 ; i < started ; i++ )
+		recorder_commit(recorders[i]);
+	cpu = cpu_time() - cpu;
+	begin = g_get_monotonic_time() - begin;
+
+	for( i = 0 ; i < count && recorders[i] ; i++ ){
+		if( recorder_get_write_behind_stats(recorders[i], &stats) == RECORDER_ERROR_NONE ){
+			bytes += stats.bytes_written;
+			writes += stats.write_count;
+			stalls += stats.stall_count;
+			if( stats.high_water > high_water )
+				high_water = stats.high_water;
+		}
+		recorder_unprepare(recorders[i]);
+		recorder_destroy(recorders[i]);
+	}
+	g_free(recorders);
+
+	if( ret == RECORDER_ERROR_NONE ){
+		printf("%-10s recorders %3d  cpu %8lld us (%5.2f%%)  writes %6d  bytes %10llu  stalls %4d  high water %7d\n", name, count,
+			(long long)cpu, begin > 0 ? cpu * 100.0 / begin : 0.0, writes, bytes, stalls, high_water);
+	}
+	return ret;
+}
+
+int main(int argc, char **argv){
+	int count = argc > 1 ? atoi(argv[1]) : DEFAULT_RECORDERS;
+	int take_ms = argc > 2 ? atoi(argv[2]) : DEFAULT_TAKE_MS;
+	const char *dir = argc > 3 ? argv[3] : "/tmp";
+	int fail = 0;
+
+	if( count < 1 )
+		count = 1;
+
+	if( run("pwrite", RECORDER_WRITER_BACKEND_WRITE, count, take_ms, dir) != RECORDER_ERROR_NONE )
+		fail++;
+	if( run("io_uring", RECORDER_WRITER_BACKEND_IO_URING, count, take_ms, dir) != RECORDER_ERROR_NONE )
+		fail++;
+
+	return fail;
+}